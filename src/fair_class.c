@@ -0,0 +1,450 @@
+// PRIORITY scheduling class with weighted fair sharing.
+// Instead of running levels by strict precedence, every PRIORITY based process receives
+// CPU time in proportion to a weight given by its level, by always running the process
+// which has received the least weighted time so far (its virtual runtime).
+#include <stdlib.h>
+#include <stdio.h>
+#include "sched_class.h"
+
+// Fair Tree: internal abstract data type.
+// It is a red-black tree ordered by the virtual runtime of each process, so the
+// process that is furthest behind its share is always the leftmost node, and both
+// picking it and putting it back after it runs are O(log n).
+
+// weight of a priority level in the fair class, inversely proportional to the level
+// just like the weighted sum of the strict class. 840 is the least common multiple of 1 through 8,
+// so every weight is exact and a level P runs P + 1 times slower in virtual time than level 0.
+#define FAIR_WEIGHT(priority) (840 / ((priority) + 1))
+
+struct fair_node{
+    Process p;
+    // virtual runtime in milliseconds, scaled by the weight of the process.
+    unsigned long long vruntime;
+    // insertion order, so that processes with the same vruntime are served first come first serve.
+    unsigned long long seq;
+    char red;
+    // whether the node is in the tree. Nodes of processes which were popped off the tree are kept
+    // by their jobs, so that processes keep their vruntime, and linked through prev_out and next_out.
+    char queued;
+    struct fair_node* prev_out;
+    struct fair_node* next_out;
+    struct fair_node* left;
+    struct fair_node* right;
+    struct fair_node* parent;
+};
+
+typedef struct fair_node* FairNode;
+
+struct fair_tree{
+    FairNode root;
+    // cached leftmost node, i.e. the next process to run.
+    FairNode leftmost;
+    // nodes of the processes popped off the tree, last popped first.
+    // The last popped is the one currently running.
+    FairNode out;
+    // monotonic lower bound for vruntimes, used to place newly arrived processes.
+    unsigned long long min_vruntime;
+    // counter used to fill the seq field of nodes.
+    unsigned long long seq;
+    // number of processes in the tree.
+    unsigned int size;
+};
+
+typedef struct fair_tree* FairTree;
+
+static FairTree createFairTree(){
+    FairTree new = (FairTree) malloc(sizeof(struct fair_tree));
+    if(!new) handle("no memory to create the fair tree of PRIORITY based processes\n");
+    new->root = NULL;
+    new->leftmost = NULL;
+    new->out = NULL;
+    new->min_vruntime = 0;
+    new->seq = 0;
+    new->size = 0;
+    return new;
+}
+
+// ordering of the tree: by vruntime, then by arrival.
+static char fair_less(FairNode a, FairNode b){
+    return a->vruntime < b->vruntime || (a->vruntime == b->vruntime && a->seq < b->seq);
+}
+
+static FairNode fair_min(FairNode x){
+    while (x && x->left) x = x->left;
+    return x;
+}
+
+// in-order successor of a node.
+static FairNode fair_next(FairNode x){
+    if (x->right) return fair_min(x->right);
+    FairNode y = x->parent;
+    while (y && x == y->right){
+        x = y;
+        y = y->parent;
+    }
+    return y;
+}
+
+static void rotate_left(FairTree t, FairNode x){
+    FairNode y = x->right;
+    x->right = y->left;
+    if (y->left) y->left->parent = x;
+    y->parent = x->parent;
+    if (!x->parent) t->root = y;
+    else if (x == x->parent->left) x->parent->left = y;
+    else x->parent->right = y;
+    y->left = x;
+    x->parent = y;
+}
+
+static void rotate_right(FairTree t, FairNode x){
+    FairNode y = x->left;
+    x->left = y->right;
+    if (y->right) y->right->parent = x;
+    y->parent = x->parent;
+    if (!x->parent) t->root = y;
+    else if (x == x->parent->right) x->parent->right = y;
+    else x->parent->left = y;
+    y->right = x;
+    x->parent = y;
+}
+
+static void insertFair(FairTree t, FairNode z){
+    FairNode y = NULL;
+    FairNode x = t->root;
+    // whether we only walked left, in which case z is the new leftmost node.
+    char leftmost = 1;
+    while (x){
+        y = x;
+        if (fair_less(z, x)) x = x->left;
+        else {
+            x = x->right;
+            leftmost = 0;
+        }
+    }
+    z->parent = y;
+    z->left = NULL;
+    z->right = NULL;
+    z->red = 1;
+    if (!y) t->root = z;
+    else if (fair_less(z, y)) y->left = z;
+    else y->right = z;
+    if (leftmost) t->leftmost = z;
+
+    // restore the red-black properties.
+    while (z->parent && z->parent->red){
+        FairNode g = z->parent->parent;
+        if (z->parent == g->left){
+            FairNode u = g->right;
+            if (u && u->red){
+                z->parent->red = 0;
+                u->red = 0;
+                g->red = 1;
+                z = g;
+            }
+            else {
+                if (z == z->parent->right){
+                    z = z->parent;
+                    rotate_left(t, z);
+                }
+                z->parent->red = 0;
+                z->parent->parent->red = 1;
+                rotate_right(t, z->parent->parent);
+            }
+        }
+        else {
+            FairNode u = g->left;
+            if (u && u->red){
+                z->parent->red = 0;
+                u->red = 0;
+                g->red = 1;
+                z = g;
+            }
+            else {
+                if (z == z->parent->left){
+                    z = z->parent;
+                    rotate_right(t, z);
+                }
+                z->parent->red = 0;
+                z->parent->parent->red = 1;
+                rotate_left(t, z->parent->parent);
+            }
+        }
+    }
+    t->root->red = 0;
+    t->size++;
+}
+
+// replaces the subtree rooted at u by the one rooted at v.
+static void transplant(FairTree t, FairNode u, FairNode v){
+    if (!u->parent) t->root = v;
+    else if (u == u->parent->left) u->parent->left = v;
+    else u->parent->right = v;
+    if (v) v->parent = u->parent;
+}
+
+// Since leaves are NULL, the parent of x is passed along explicitly.
+static void removeFairFixup(FairTree t, FairNode x, FairNode xp){
+    FairNode w;
+    while (x != t->root && (!x || !x->red)){
+        if (x == xp->left){
+            w = xp->right;
+            if (w->red){
+                w->red = 0;
+                xp->red = 1;
+                rotate_left(t, xp);
+                w = xp->right;
+            }
+            if ((!w->left || !w->left->red) && (!w->right || !w->right->red)){
+                w->red = 1;
+                x = xp;
+                xp = x->parent;
+            }
+            else {
+                if (!w->right || !w->right->red){
+                    w->left->red = 0;
+                    w->red = 1;
+                    rotate_right(t, w);
+                    w = xp->right;
+                }
+                w->red = xp->red;
+                xp->red = 0;
+                if (w->right) w->right->red = 0;
+                rotate_left(t, xp);
+                x = t->root;
+            }
+        }
+        else {
+            w = xp->left;
+            if (w->red){
+                w->red = 0;
+                xp->red = 1;
+                rotate_right(t, xp);
+                w = xp->left;
+            }
+            if ((!w->left || !w->left->red) && (!w->right || !w->right->red)){
+                w->red = 1;
+                x = xp;
+                xp = x->parent;
+            }
+            else {
+                if (!w->left || !w->left->red){
+                    w->right->red = 0;
+                    w->red = 1;
+                    rotate_left(t, w);
+                    w = xp->left;
+                }
+                w->red = xp->red;
+                xp->red = 0;
+                if (w->left) w->left->red = 0;
+                rotate_right(t, xp);
+                x = t->root;
+            }
+        }
+    }
+    if (x) x->red = 0;
+}
+
+// unlinks z from the tree, but doesnt free it.
+static void removeFair(FairTree t, FairNode z){
+    FairNode y = z;
+    FairNode x;
+    FairNode xp;
+    char y_red = y->red;
+
+    if (t->leftmost == z) t->leftmost = fair_next(z);
+
+    if (!z->left){
+        x = z->right;
+        xp = z->parent;
+        transplant(t, z, z->right);
+    }
+    else if (!z->right){
+        x = z->left;
+        xp = z->parent;
+        transplant(t, z, z->left);
+    }
+    else {
+        y = fair_min(z->right);
+        y_red = y->red;
+        x = y->right;
+        if (y->parent == z) xp = y;
+        else {
+            xp = y->parent;
+            transplant(t, y, y->right);
+            y->right = z->right;
+            y->right->parent = y;
+        }
+        transplant(t, z, y);
+        y->left = z->left;
+        y->left->parent = y;
+        y->red = z->red;
+    }
+    if (!y_red) removeFairFixup(t, x, xp);
+    t->size--;
+}
+
+// keeps min_vruntime up to date with the smallest vruntime among queued and running processes.
+static void update_min_vruntime(FairTree t){
+    unsigned long long vruntime = t->min_vruntime;
+    if (t->out) vruntime = t->out->vruntime;
+    if (t->leftmost && (!t->out || t->leftmost->vruntime < vruntime))
+        vruntime = t->leftmost->vruntime;
+    if (vruntime > t->min_vruntime) t->min_vruntime = vruntime;
+}
+
+static void* create(){
+    return createFairTree();
+}
+
+// frees nodes of a subtree along with their processes.
+static void freeFairNode(FairNode n){
+    if (!n) return;
+    freeFairNode(n->left);
+    freeFairNode(n->right);
+    free_process(n->p);
+    free(n);
+}
+
+// links a node popped off the tree in the list of nodes out of the tree.
+static void push_out(FairTree t, FairNode node){
+    node->queued = 0;
+    node->prev_out = NULL;
+    node->next_out = t->out;
+    if (t->out) t->out->prev_out = node;
+    t->out = node;
+}
+
+static void unlink_out(FairTree t, FairNode node){
+    if (node->prev_out) node->prev_out->next_out = node->next_out;
+    else t->out = node->next_out;
+    if (node->next_out) node->next_out->prev_out = node->prev_out;
+}
+
+// frees processes too, except the popped ones which are not in the tree.
+static void destroy(void* rq){
+    FairTree t = rq;
+    freeFairNode(t->root);
+    while (t->out){
+        FairNode aux = t->out;
+        t->out = aux->next_out;
+        free(aux);
+    }
+    free(t);
+}
+
+// Puts a process in the tree.
+// If the process was popped before, it keeps its vruntime, which was charged
+// by tick. Otherwise it is a new process and starts at min_vruntime,
+// so it neither starves the others nor is starved by them.
+static char enqueue(ProcessTable table, void* rq, Process p, unsigned short cur_policy, unsigned char cur_time, unsigned int time_run_last){
+    FairTree t = rq;
+    FairNode* slot = (FairNode*) job_node(table, p);
+    FairNode node = *slot;
+    if (node && node->queued) return 0; // already queued.
+    if (node) unlink_out(t, node);
+    else {
+        node = (FairNode) malloc(sizeof(struct fair_node));
+        if(!node) handle("no memory to create fair tree node for process at %s\n", path(p));
+        node->p = p;
+        node->vruntime = t->min_vruntime;
+        *slot = node;
+    }
+    node->seq = t->seq++;
+    node->queued = 1;
+    insertFair(t, node);
+    update_min_vruntime(t);
+
+    // No preemption should occur in favour of a fair process.
+    // The slices handed out by the class are short enough that an added
+    // process never waits long for its turn, see fair_slice.
+    return 0;
+}
+
+// The node of the process is kept by its job, so it is removed in O(log n).
+static char dequeue(ProcessTable table, void* rq, Process p){
+    FairTree t = rq;
+    FairNode* slot = (FairNode*) job_node(table, p);
+    FairNode node = *slot;
+    if (!node) return 0;
+    char queued = node->queued;
+    if (queued) removeFair(t, node);
+    else unlink_out(t, node);
+    free(node);
+    *slot = NULL;
+    update_min_vruntime(t);
+    return queued;
+}
+
+// The tree is ordered by vruntime, which the process keeps, so it stays where it is.
+// Only the time it runs from now on is charged with its new weight.
+static char change(ProcessTable table, void* rq, Process p, unsigned short new_policy, unsigned short cur_policy, unsigned char cur_time){
+    set_policy(p, new_policy);
+    return 0;
+}
+
+// Pops the process with the smallest vruntime off the tree.
+static Process pick_next(ProcessTable table, void* rq, unsigned char cur_time){
+    FairTree t = rq;
+    FairNode node = t->leftmost;
+    if (!node) return NULL;
+    removeFair(t, node);
+    push_out(t, node);
+    update_min_vruntime(t);
+    return node->p;
+}
+
+// fair processes run for a fair slice, but never past the next REAL-TIME process.
+static unsigned int slice_for(ProcessTable table, void* rq, Process p, unsigned char cur_time){
+    char time = time_to_next_real_time(table, cur_time);
+    unsigned int slice = fair_slice(rq);
+    return time >= 0 && time * 1000 < slice ? time * 1000 : slice;
+}
+
+// charges a popped process for the time it ran, weighted by its priority.
+static void tick(ProcessTable table, void* rq, Process p, unsigned int time_ran){
+    FairNode node = *job_node(table, p);
+    if (node && !node->queued)
+        node->vruntime += (unsigned long long) time_ran * FAIR_WEIGHT(0) / FAIR_WEIGHT(GET_PRIORITY(policy(p)));
+}
+
+// vruntimes carry over from one minute to the next.
+static void reset_period(void* rq){ }
+
+static void dump(void* rq){
+    FairTree t = rq;
+    if (!t->size){
+        printf("\tNo PRIORITY based processes.\n");
+        return;
+    }
+    puts("\tFAIR PRIORITY BASED PROCESSES:");
+    printf("\tMinimum virtual runtime: %llu.\n", t->min_vruntime);
+    printf("\n");
+    for (FairNode node = t->leftmost; node; node = fair_next(node)){
+        print_process(node->p);
+        printf("\t\twith priority %d and virtual runtime %llu.\n", GET_PRIORITY(policy(node->p)), node->vruntime);
+    }
+}
+
+const struct sched_class fair_sched = {
+    .name = "FAIR PRIORITY",
+    .create = create,
+    .destroy = destroy,
+    .enqueue = enqueue,
+    .dequeue = dequeue,
+    .change = change,
+    .pick_next = pick_next,
+    .slice_for = slice_for,
+    .tick = tick,
+    .reset_period = reset_period,
+    .dump = dump,
+};
+
+// Slices shrink as more processes are queued so that all of them run once every FAIR_LATENCY
+// milliseconds, but never below FAIR_MIN_SLICE.
+unsigned short fair_slice(void* rq){
+    FairTree t = rq;
+    unsigned int running = t->size + (t->out ? 1 : 0);
+    unsigned int slice = FAIR_LATENCY / (running ? running : 1);
+    return slice < FAIR_MIN_SLICE ? FAIR_MIN_SLICE : slice;
+}
@@ -167,6 +167,14 @@ static Process compile_instruction(char* instruction){
         
         process_policy = REAL_TIME | (pI ? SET_I(pI) : MAKES_REFERENCE) | SET_D(pD);
     }
+    // REAL-TIME process with no start time, which the scheduler places in the earliest free
+    // interval of the minute, or of the window given by W=earliest-latest.
+    // e.g. Run prog D=5, or Run prog D=5 W=10-40,
+    else if (!strncmp(" D=", instruction + path_len, 3)){
+        int duration = 0, earliest = 0, latest = 60;
+        sscanf(instruction + path_len, " D=%d W=%d-%d,", &duration, &earliest, &latest);
+        return create_process_with_window(process_path, REAL_TIME | SET_D(duration), earliest, latest);
+    }
     else if (instruction[path_len] == ','){
         sscanf(instruction[path_len + 1], " Quantum=%d.", &quantum);
         process_policy = ROUND_ROBIN | SET_ROBIN_TIME(quantum);
@@ -0,0 +1,258 @@
+// PRIORITY scheduling class with strict levels.
+// Lower levels always run before higher ones, but each level may only run for a share
+// of every minute, after which it is blocked until the minute is over.
+#include <stdlib.h>
+#include <stdio.h>
+#include <assert.h>
+#include "sched_class.h"
+#include "process_queue.h"
+
+// time limits as percentages that each priority queue is allowed to occupy of the total CPU time. 
+// sums 95.5, 0.5 seconds is used to run a single round robin process at a time.
+// static const float priority_time_limits[8] = {36.7, 18.3, 12.1, 9.0, 7.2, 6.2, 5.3, 4.7};
+
+// The run queue of the class.
+struct priority_queue{
+    // uses 8 bits to verify for each priority level whether processes in it can run or not.
+    // least significant bit used for 0 priority.
+    unsigned char priority_runnable;
+    // queues of priority based processes.
+    ProcessQueue levels[PRIOR_LEVELS];
+    // amount of maximum time each priority level is allowed to run;
+    float priority_time_limits[PRIOR_LEVELS];
+    // a weighted sum used to calculate priority_time_limits.
+    float priority_total;
+};
+
+typedef struct priority_queue* PriorityQueue;
+
+static void* create(){
+    PriorityQueue new = (PriorityQueue) malloc(sizeof(struct priority_queue));
+    if (!new) handle("no memory to create area for storing PRIORITY based processes\n");
+    new->priority_runnable = 0xFF; // sets all bits to 1.
+    // make sure there is no garbage in the table which might accidentally evaluate to true.
+    for (unsigned char i = 0; i < PRIOR_LEVELS; i++){
+        new->levels[i] = NULL;
+        new->priority_time_limits[i] = 0;
+    }
+    new->priority_total = 0.0; // when there are no processes there is no sum.
+    return new;
+}
+
+static void destroy(void* rq){
+    PriorityQueue q = rq;
+    for (unsigned char i = 0; i < PRIOR_LEVELS; i++)
+        if(q->levels[i]) freeQueue(q->levels[i]);
+    free(q);
+}
+
+// checks the runnable mask for whether a given priority level can run.
+static char runnable(PriorityQueue q, unsigned char priority){
+    return (q->priority_runnable >> priority) & 1;
+}
+
+// flips the runnable flag of a priority level.
+static void flip_runnable(PriorityQueue q, unsigned char priority){
+    q->priority_runnable ^= 1 << priority;
+}
+
+// decides whether a priority level is allowed to run or not.
+// if it cant, it is set as not runnable, and run times for priority queues are cleared.
+static void can_run(ProcessTable table, PriorityQueue q, unsigned char priority){
+    assert(priority < PRIOR_LEVELS);
+    assert(q->levels[priority]);
+    
+    // time avaible for priority and round robin processes, in seconds.
+    // This includes the slack REAL-TIME processes left this minute, since they didn't use it.
+    void* real_time = class_queue(table, CLASS_REAL_TIME);
+    float time_avail = 60 - real_time_reserved(real_time) + real_time_slack(real_time) / 1000.0;
+    
+    // time avaible for the given priority level.
+    float priority_time = q->priority_time_limits[priority] * PRIORITY_TIME * time_avail;
+
+    // if the time the priority level has run is greater than the avaible time, it should not continue
+    // to run until the next minute.
+    if ((q->levels[priority]->time_run / 1000.0) > priority_time){
+        if (runnable(q, priority)) flip_runnable(q, priority);
+        q->levels[priority]->time_run = 0;
+    }
+}
+
+// if the level is empty it is not being counted in the weighted sum,
+// so when a process is added to it, it should start counting.
+static void count_level(PriorityQueue q, unsigned char priority){
+    // update sum with value inversely proportional to priority level
+    float add = 1.0/(priority + 1);
+    q->priority_total += add;
+    // priority time limits are fractions of the total sum.
+    q->priority_time_limits[priority] = add/q->priority_total;
+}
+
+// when a level is made empty, the total weighted sum must be updated.
+static void uncount_level(PriorityQueue q, unsigned char priority){
+    float subtract = 1.0/(priority + 1);
+    q->priority_total -= subtract;
+    q->priority_time_limits[priority] = 0.0;
+}
+
+static char enqueue(ProcessTable table, void* rq, Process p, unsigned short cur_policy, unsigned char cur_time, unsigned int time_run_last){
+    PriorityQueue q = rq;
+    unsigned char priority = GET_PRIORITY(policy(p));
+    if (!q->levels[priority]) q->levels[priority] = createQueue();
+    
+    if (queueEmpty(q->levels[priority])) count_level(q, priority);
+
+    // time run was already added to the level by tick.
+    *job_node(table, p) = insertQueue(q->levels[priority], p, 0); // add to queue
+
+    // we should determine based on this addition whether the priority level of the added process
+    // has already run enough or can keep running.
+    can_run(table, q, priority);
+
+    // We must now figure out whether preemption should occur or not.
+    // If there is no process currently running, it should not.
+    if (!cur_policy) return 0;
+
+    // preemption should only occur for a process that has not yet run (this minute)
+    // when the current process is also priority based and the added process 
+    // has greater priority then the current one.
+    // It should also be checked whether the priority level of the added process can still keep running
+    return !time_run_last && 
+           POLICY_PRIORITY(cur_policy) &&
+           priority > GET_PRIORITY(cur_policy) &&
+           runnable(q, priority);
+}
+
+// the job of the process keeps its node in the level.
+static char dequeue(ProcessTable table, void* rq, Process p){
+    PriorityQueue q = rq;
+    unsigned char priority = GET_PRIORITY(policy(p));
+    void** node = job_node(table, p);
+    if (!*node) return 0;
+    removeNode(q->levels[priority], *node);
+    *node = NULL;
+    if (queueEmpty(q->levels[priority])) uncount_level(q, priority);
+    return 1;
+}
+
+// The process moves to the end of its new level.
+// A process which is running enters its new level when it is put back.
+static char change(ProcessTable table, void* rq, Process p, unsigned short new_policy, unsigned short cur_policy, unsigned char cur_time){
+    if (!dequeue(table, rq, p)){
+        set_policy(p, new_policy);
+        return 0;
+    }
+    set_policy(p, new_policy);
+    return enqueue(table, rq, p, cur_policy, cur_time, 0);
+}
+
+static Process pick_next(ProcessTable table, void* rq, unsigned char cur_time){
+    PriorityQueue q = rq;
+
+    // We figure out which priority level should be run by taking
+    // the level with the greatest priority which is runnable and not empty.
+    ProcessQueue level = NULL;
+    unsigned char priority;
+    for (priority = 0; priority < PRIOR_LEVELS; priority++){
+        level = q->levels[priority];
+        if (level && !queueEmpty(level) && runnable(q, priority))
+            break;
+        else level = NULL;
+    }
+    
+    if (!level) return NULL;
+
+    // We pop the first process off the level queue.
+    Process to_run = popQueue(level);
+    *job_node(table, to_run) = NULL;
+
+    // Since we popped a process, we need to figure out whether this casused
+    // the queue to be made empty.
+    if (queueEmpty(level)) uncount_level(q, priority);
+    
+    return to_run;
+}
+
+// PRIORITY based processes may run until the next REAL-TIME process.
+static unsigned int slice_for(ProcessTable table, void* rq, Process p, unsigned char cur_time){
+    char time = time_to_next_real_time(table, cur_time);
+    return time < 0 ? 10000 : time * 1000;
+}
+
+static void tick(ProcessTable table, void* rq, Process p, unsigned int time_ran){
+    PriorityQueue q = rq;
+    unsigned char priority = GET_PRIORITY(policy(p));
+    if (!q->levels[priority]) q->levels[priority] = createQueue();
+    q->levels[priority]->time_run += time_ran;
+}
+
+static void reset_period(void* rq){
+    PriorityQueue q = rq;
+    // Reset time run for priority processes.
+    for (unsigned char i = 0; i < PRIOR_LEVELS; i++)
+        if (q->levels[i]) 
+            q->levels[i]->time_run = 0;
+
+    // All levels are now allowed to run.
+    q->priority_runnable = 0xFF;
+}
+
+static void dump(void* rq){
+    PriorityQueue q = rq;
+    ProcessQueue level;
+    unsigned char numlevels = 0;
+    unsigned char blocked_levels = 0;
+    unsigned int total_priority_time = 0;
+    int i;
+
+    // figure out number of total, active, empty and blocked levels.
+    for (i = 0; i < PRIOR_LEVELS; i++){
+        level = q->levels[i];
+        if  (level && !queueEmpty(level)){
+            numlevels++;
+            total_priority_time += level->time_run;
+            if (!runnable(q, i)) blocked_levels++;
+        } 
+    }
+
+    if (!numlevels){
+        printf("\tNo PRIORITY based processes.\n");
+        return;
+    }
+
+    puts("\tPRIORITY BASED PROCESSES:");
+    printf("\tTotal time used: %d milliseconds.\n", total_priority_time);
+    printf("\tActive levels: %d.\n", numlevels - blocked_levels);
+    printf("\tBlocked levels: %d.\n", blocked_levels);
+    printf("\tEmpty levels: %d.\n", PRIOR_LEVELS - numlevels);
+    printf("\n");
+
+    for (i = 0; i < PRIOR_LEVELS; i++){
+        level = q->levels[i];
+        if (level && !queueEmpty(level)){
+            printf("\tPRIORITY LEVEL %d.\n", i);
+            printf("\tStatus: %s.\n", runnable(q, i) ? "ACTIVE" : "BLOCKED");
+            printf("\n");
+            for (Node process = level->head; process; process = process->next){
+                print_process(process->p);
+                printf(".\n");
+            }
+            printf("\tTime run: %d.\n", level->time_run);
+            printf("\n");
+        }
+    }
+}
+
+const struct sched_class priority_sched = {
+    .name = "PRIORITY",
+    .create = create,
+    .destroy = destroy,
+    .enqueue = enqueue,
+    .dequeue = dequeue,
+    .change = change,
+    .pick_next = pick_next,
+    .slice_for = slice_for,
+    .tick = tick,
+    .reset_period = reset_period,
+    .dump = dump,
+};
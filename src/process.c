@@ -13,8 +13,14 @@ struct process{
     char path[MAX_PATH];
     char Ipath[MAX_PATH]; // path that could be specified with the I option.
     unsigned short policy; // this is configured by bits. See the macros in shared_defs.h for details.
+    // window of the minute in which a REAL-TIME process may be placed by the scheduler.
+    // Both are 0 if the process was given an explicit start time.
+    unsigned char earliest;
+    unsigned char latest;
     // PID of process is only used by sheduler. Defaults to 0.
     int pid;
+    // handle of the job of the process in the process table. Defaults to NO_JOB.
+    JobHandle handle;
 };
 
 // Creates a new Process.
@@ -28,7 +34,10 @@ Process create_process(const char* path, unsigned short policy){
     strcpy(new->path, path);
     strcpy(new->Ipath, "");
     new->policy = policy;
+    new->earliest = 0;
+    new->latest = 0;
     new->pid = 0;
+    new->handle = NO_JOB;
     return new;
 }
 
@@ -43,6 +52,21 @@ Process create_process_with_relative_schedule(const char* path, char* Ipath, uns
     return new;
 }
 
+// Creates a REAL-TIME process which is placed by the scheduler in the earliest free interval
+// of the minute which starts at or after earliest and ends at or before latest.
+Process create_process_with_window(const char* path, unsigned short policy, unsigned char earliest, unsigned char latest){
+    Process new;
+    if(!POLICY_REAL_TIME(policy) || POLICY_MAKES_REFERENCE(policy))
+        handle("only REAL-TIME processes which make no reference can be placed by the scheduler: %s\n", path);
+    if(latest > 60 || earliest + GET_D(policy) > latest)
+        handle("window [%d, %d] does not fit process at %s\n", earliest, latest, path);
+    // the I value is meaningless until the process is placed.
+    new = create_process(path, (policy & 0x3FF) | SET_I(earliest));
+    new->earliest = earliest;
+    new->latest = latest;
+    return new;
+}
+
 // Process policy.
 unsigned short policy(Process p){
     return p->policy;
@@ -110,6 +134,44 @@ void resolve(Process p, unsigned char start_time){
     p->policy = (p->policy & 0x3FF) | SET_I(start_time);
 }
 
+// Changes the policy of a process, see shared_defs.h for the rules.
+void set_policy(Process p, unsigned short policy){
+    handle_policy(policy);
+    if(POLICY_MAKES_REFERENCE(policy) != POLICY_MAKES_REFERENCE(p->policy))
+        handle("attempted to change whether process at %s makes reference.\n", p->path);
+    if(!POLICY_REAL_TIME(policy)){
+        p->earliest = 0;
+        p->latest = 0;
+    }
+    else if(placeable(p) && p->earliest + GET_D(policy) > p->latest)
+        handle("window [%d, %d] does not fit process at %s\n", p->earliest, p->latest, p->path);
+    p->policy = policy;
+}
+
+// Whether the process asked to be placed by the scheduler.
+char placeable(Process p){
+    return p->latest != 0;
+}
+
+// Window of the minute in which a placeable process may run.
+unsigned char window_start(Process p){
+    return p->earliest;
+}
+
+unsigned char window_end(Process p){
+    return p->latest;
+}
+
+// A placeable process can be changed by this routine so as to have its STIME value changed to start_time.
+// An error will be generated if the process is not placeable or if it would not fit its window.
+void place(Process p, unsigned char start_time){
+    if(!placeable(p))
+        handle("attempted to place process at %s which has an explicit start time.\n", p->path);
+    if(start_time < p->earliest || start_time + GET_D(p->policy) > p->latest)
+        handle("attempted to place process at %s outside of its window.\n", p->path);
+    p->policy = (p->policy & 0x3FF) | SET_I(start_time);
+}
+
 // Free the memory associated with the process.
 void free_process(Process p){
     if (p->pid) 
@@ -121,6 +183,8 @@ void free_process(Process p){
 Process process_deep_copy(Process p){
     if (POLICY_MAKES_REFERENCE(p->policy))
         return create_process_with_relative_schedule(p->path, p->Ipath, p->policy);
+    if (placeable(p))
+        return create_process_with_window(p->path, p->policy, p->earliest, p->latest);
     return create_process(p->path, p->policy);
 }
 
@@ -140,6 +204,13 @@ int get_pid(Process p) {
 
 int set_pid(Process p, int pid) { p->pid = pid; }
 
+JobHandle get_handle(Process p){
+    assert(p);
+    return p->handle;
+}
+
+void set_handle(Process p, JobHandle handle){ p->handle = handle; }
+
 // Print process to stdout.
 void print_process(Process p){
     assert(p);
@@ -149,6 +220,9 @@ void print_process(Process p){
     if (POLICY_MAKES_REFERENCE(pol))
         printf("\t\trefers to %s\n", p->Ipath);
 
+    if (placeable(p))
+        printf("\t\tplaced in window [%d, %d]\n", p->earliest, p->latest);
+
     if (POLICY_REAL_TIME(pol)){
         printf("\t\tstarts at %d\n", GET_I(pol));
         printf("\t\tends at %d\n", PETIME(pol));
@@ -0,0 +1,71 @@
+#include <stdlib.h>
+#include "process_queue.h"
+
+// create Node
+static Node cNode(Process p){
+    Node new = (Node) malloc(sizeof(struct queue_node));
+    if(!new) handle("no memory to create process table node for process at %s\n", path(p));
+    new->p = p;
+    new->next = NULL;
+    new->prev = NULL;
+    return new;
+}
+
+// notice this doesnt liberate only the list of nodes, but also the processes.
+static void freeNode(Node n){
+    if(!n) return;
+    freeNode(n->next);
+    free_process(n->p);
+    free(n);
+}
+
+// create empty process queue.
+ProcessQueue createQueue(){
+    ProcessQueue new = (ProcessQueue) malloc(sizeof(struct pqueue));
+    if(!new) handle("no memory to create a new priority queue of processes.\n");
+    new->head = NULL;
+    new->last = NULL;
+    new->time_run = 0;
+    return new;
+}
+
+Node insertQueue(ProcessQueue queue, Process p, unsigned int addtime){
+    Node new = cNode(p);
+    if(!queue->head){
+        queue->head = new;
+        queue->last = new;
+    }
+    else {
+        new->prev = queue->last;
+        queue->last->next = new;
+        queue->last = new;
+    }
+    if(addtime) queue->time_run += addtime;
+    return new;
+}
+
+Process popQueue(ProcessQueue queue){
+    if (!queue || !queue->head)
+        return NULL;
+    Process p = queue->head->p;
+    removeNode(queue, queue->head); // this doesnt free the processes in the node list.
+    return p;
+}
+
+void removeNode(ProcessQueue queue, Node node){
+    if (node->prev) node->prev->next = node->next;
+    else queue->head = node->next;
+    if (node->next) node->next->prev = node->prev;
+    else queue->last = node->prev;
+    free(node);
+}
+
+char queueEmpty(ProcessQueue queue){
+    return queue->head ? 0 : 1;
+}
+
+// frees processes too
+void freeQueue(ProcessQueue queue){
+    freeNode(queue->head);
+    free(queue);
+}
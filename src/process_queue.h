@@ -0,0 +1,43 @@
+// Process Queue: abstract data type internal to the ProcessTable.
+// Used for storing priority based and ROUND-ROBIN processes.
+#pragma once
+#include "shared_defs.h"
+
+// Node for queue. It is implemented as a doubly linked list,
+// so that a process can be taken out of the middle of the queue given its node.
+struct queue_node{
+    Process p;
+    struct queue_node* next;
+    struct queue_node* prev;
+};
+
+typedef struct queue_node* Node;
+
+// The actual queue.
+struct pqueue{
+    Node head;
+    Node last;
+    // number of milliseconds the processes in this queue were run
+    //since the queue has been allowed to run.
+    unsigned int time_run; 
+};
+
+typedef struct pqueue* ProcessQueue;
+
+// create empty process queue.
+ProcessQueue createQueue();
+
+// adds p to the end of the queue, and addtime milliseconds to the time run by the queue.
+// Returns the node of p, which stays valid until p leaves the queue.
+Node insertQueue(ProcessQueue queue, Process p, unsigned int addtime);
+
+// removes the process at the head of the queue, returning NULL if the queue is empty.
+Process popQueue(ProcessQueue queue);
+
+// removes the node of a process from the queue in O(1), without freeing the process.
+void removeNode(ProcessQueue queue, Node node);
+
+char queueEmpty(ProcessQueue queue);
+
+// frees processes too
+void freeQueue(ProcessQueue queue);
@@ -3,521 +3,376 @@
 #include <string.h>
 #include <assert.h>
 #include "process_table.h"
-#include "rax/rax.h"
-
-// Process Queue: internal abstract data type.
-// Used for storing priority based and ROUND-ROBIN processes.
-
-// Node for queue. It is implemented as a linked list.
-static struct queue_node{
+#include "sched_class.h"
+
+// Every process added to the table gets a job, whose handle stays valid until the process
+// is removed from the table, even while it is picked by next_process and running.
+// Jobs are kept in an array, and a handle is the index of the job plus 1 in its lower bits and
+// a generation number, which changes whenever the job is reused, in its upper bits.
+// This way handles are looked up in O(1), and stale handles are detected.
+#define JOB_INDEX_BITS 22
+#define JOB_GENERATION_MASK ((1u << (32 - JOB_INDEX_BITS)) - 1)
+#define JOB_HANDLE(index, generation) (((generation) << JOB_INDEX_BITS) | ((index) + 1))
+#define JOB_INDEX(handle) (((handle) & ((1u << JOB_INDEX_BITS) - 1)) - 1)
+
+struct job{
+    // process of the job, or NULL if the job is free.
     Process p;
-    struct queue* next;
+    // node of the process in the run queue of its class, see job_node.
+    void* node;
+    unsigned int generation;
+    // index plus 1 of the next free job, or 0 if there is none.
+    unsigned int next_free;
+    // PID under which the job is in the PID index, or 0.
+    int pid;
+};
 
+// PID index: open addressing hash table from PIDs to jobs, with linear probing.
+// Slots with PID 0 are empty. It is kept at most half full, and entries are removed by
+// shifting the entries after them back, so lookups never go through deleted slots.
+struct pid_slot{
+    int pid;
+    unsigned int job;
 };
 
-typedef struct queue_node* Node;
+// The process table only dispatches to its scheduling classes, see sched_class.h.
+struct process_table{
+    // class in each slot, and its run queue.
+    SchedClass classes[NR_CLASSES];
+    void* queues[NR_CLASSES];
+
+    // slot of the class whose turn it is to run, among the classes which take turns.
+    unsigned char turn;
+
+    // jobs of the processes in the table.
+    struct job* jobs;
+    unsigned int nr_jobs;
+    unsigned int jobs_size;
+    // index plus 1 of the first free job, or 0 if there is none.
+    unsigned int free_jobs;
+
+    // PID index of the jobs, its number of slots, always a power of 2, and of PIDs in it.
+    struct pid_slot* pids;
+    unsigned int pids_size;
+    unsigned int nr_pids;
+};
 
-// create Node
-static Node cNode(Process p){
-    Node new = (Node) malloc(sizeof(struct queue_node));
-    if(!new) handle("no memory to create process table node for process at %s\n", path(p));
-    new->p = p;
-    new->next = NULL;
-    return new;
+// creates empty process table
+ProcessTable create_table(){
+    return create_table_with_class(STRICT_PRIORITY);
 }
 
-static void insertNode(Node head, Process ins){
-    if(!head) return;
-    Node new = cNode(ins);
-    // do be careful that it is not checked whether head->next was NULL or not.
-    // we simply assume that we will never have to insert in a node in which it isnt,
-    // so we can avoid the check.
-    head->next = new;
-}
+// creates empty process table which runs the given implementation of the PRIORITY class.
+ProcessTable create_table_with_class(char priority_class){
+    assert(priority_class == STRICT_PRIORITY || priority_class == FAIR_PRIORITY);
+    ProcessTable new = (ProcessTable) malloc(sizeof(struct process_table));
+    if (!new) handle("no memory to create process table\n");
 
-// notice this doesnt liberate only the list of nodes, but also the processes.
-static void freeNode(Node n){
-    if(!n) return;
-    freeNode(n->next);
-    free_process(n->p);
-    free(n);
-}
+    new->classes[CLASS_REAL_TIME] = &real_time_sched;
+    new->classes[CLASS_PRIORITY] = priority_class == FAIR_PRIORITY ? &fair_sched : &priority_sched;
+    new->classes[CLASS_ROUND_ROBIN] = &robin_sched;
+    for (unsigned char i = 0; i < NR_CLASSES; i++)
+        new->queues[i] = new->classes[i]->create();
 
-// The actual queue.
-static struct pqueue{
-    Node head;
-    Node last;
-    // number of milliseconds the processes in this queue were run
-    //since the queue has been allowed to run.
-    unsigned int time_run; 
-};
+    // by default, we expect priority run mode to have precedence.
+    new->turn = FIRST_BEST_EFFORT;
 
-typedef struct pqueue* ProcessQueue;
+    new->jobs = NULL;
+    new->nr_jobs = 0;
+    new->jobs_size = 0;
+    new->free_jobs = 0;
 
-// create empty process queue.
-static ProcessQueue createQueue(){
-    ProcessQueue new = (ProcessQueue) malloc(sizeof(struct pqueue));
-    if(!new) handle("no memory to create a new priority queue of processes. %s\n");
-    new->head = NULL;
-    new->last = NULL;
-    new->time_run = 0;
+    new->pids = NULL;
+    new->pids_size = 0;
+    new->nr_pids = 0;
     return new;
 }
 
-static void insertQueue(ProcessQueue queue, Process p, unsigned int addtime){
-    Node new = cNode(p);
-    if(!queue->head){
-        queue->head = new;
-        queue->last = new;
-    }
-    else {
-        queue->last->next = new;
-        queue->last = new;
-    }
-    if(addtime) queue->time_run += addtime;
-}
-
-static Process popQueue(ProcessQueue queue){
-    if (!queue || !queue->head)
-        return NULL;
-    Process p = queue->head->p;
-    Node aux = queue->head;
-    queue->head = queue->head->next;
-    free(aux); // this doesnt free the processes in the node list.
-    return p;
+// frees the process table
+void free_table(ProcessTable table){
+    // I think by now there is no need to remind the reader that assertions should be disabled in production.
+    assert(table);
+    for (unsigned char i = 0; i < NR_CLASSES; i++)
+        table->classes[i]->destroy(table->queues[i]);
+    free(table->jobs);
+    free(table->pids);
+    free(table);
 }
 
-static char queueEmpty(ProcessQueue queue){
-    return queue->head ? 0 : 1;
+// Gets the run queue of a class slot in the table.
+void* class_queue(ProcessTable table, unsigned char cls){
+    return table->queues[cls];
 }
 
-// frees processes too
-static void freeQueue(ProcessQueue queue){
-    freeNode(queue->head);
-    free(queue);
+// slot of the PID index where a PID is, or should be put.
+static unsigned int pid_slot(ProcessTable table, int pid){
+    // Fibonacci hashing spreads consecutive PIDs over the table.
+    unsigned int i = ((unsigned int) pid * 2654435769u) & (table->pids_size - 1);
+    while (table->pids[i].pid && table->pids[i].pid != pid)
+        i = (i + 1) & (table->pids_size - 1);
+    return i;
 }
 
-// Heap for keeping REAL-TIME processes. It is actually implemented as an ordered array.
-// Ideally I would implement a binary search tree to avoid the costs of using insertion sort 
-// to insert into the heap array, or use a more sophisticated online sorting algorithm than insertion
-// and still mantain the array based implementation. But if I keep thinking about optmizing data structures
-// I am never going to actually finish this project, so insertion sort it is.
-static struct process_heap{
-    // the array of processes.
-	Process node[MAX_RTIME];
-
-    // flag tells whether given process ran this minute.
-    char ran[MAX_RTIME];
-
-    // total time in seconds used each 60 seconds for REAL-TIME processes in the heap.
-    char time_used;
-    
-    // size of heap array.
-	int size;
-};
-
-typedef struct process_heap* ProcessHeap;
-
-static ProcessHeap createHeap(){
-	ProcessHeap new = (ProcessHeap) malloc(sizeof(struct process_heap));
-	if(!new) 
-        handle("no memory to create area for storing information about REAL-TIME processes\n");
-    for (uint16_t i = 0; i < MAX_RTIME; i++)
-        new->ran[i] = 0;
-    new->time_used = 0;
-    new->size = 0;
-	return new;
+static void index_pid(ProcessTable table, int pid, unsigned int job){
+    if (2 * (table->nr_pids + 1) > table->pids_size){
+        // the index grows, and every PID is put in it again.
+        struct pid_slot* old = table->pids;
+        unsigned int old_size = table->pids_size;
+        table->pids_size = old_size ? old_size * 2 : 64;
+        table->pids = (struct pid_slot*) calloc(table->pids_size, sizeof(struct pid_slot));
+        if (!table->pids) handle("no memory to index the PIDs of the process table\n");
+        for (unsigned int i = 0; i < old_size; i++)
+            if (old[i].pid) table->pids[pid_slot(table, old[i].pid)] = old[i];
+        free(old);
+    }
+    unsigned int i = pid_slot(table, pid);
+    if (!table->pids[i].pid) table->nr_pids++;
+    table->pids[i].pid = pid;
+    table->pids[i].job = job;
 }
 
-// finds the position in the heap corresponding to the current time.
-// WARNING: May return position out of array bounds.
-static int bin_search(ProcessHeap h, unsigned char time){
-    if (!h || h->size <= 0) return -1;
-    int i = 0;
-    int j = h->size;
-    int m;
-    while (i < j){
-        m = (i + j)/2;
-        if (time > STIME(h->node[m])) i = m + 1;
-        else j = m;
+static void unindex_pid(ProcessTable table, int pid){
+    if (!table->pids_size) return;
+    unsigned int mask = table->pids_size - 1;
+    unsigned int i = pid_slot(table, pid);
+    if (!table->pids[i].pid) return;
+    table->nr_pids--;
+    // entries after the removed one which can't be found past the gap are shifted back.
+    for (unsigned int j = (i + 1) & mask; table->pids[j].pid; j = (j + 1) & mask){
+        unsigned int home = ((unsigned int) table->pids[j].pid * 2654435769u) & mask;
+        // the entry stays if its home is cyclically in (i, j].
+        if (((j - home) & mask) < ((j - i) & mask)) continue;
+        table->pids[i] = table->pids[j];
+        i = j;
     }
-    return i;
+    table->pids[i].pid = 0;
 }
 
-// finds the position the process should be in the heap, 
-// assuming the heap is ordered by the start time of processes.
-// WARNING: May return position out of array bounds.
-static int searchProcess(ProcessHeap h, Process p){
-    assert(h);
-    assert(p);
-    return bin_search(h, STIME(p));
+// keeps the PID index up to date with the PID of the process of a job.
+static void reindex_job(ProcessTable table, struct job* job){
+    int pid = job->p ? get_pid(job->p) : 0;
+    if (job->pid == pid) return;
+    if (job->pid) unindex_pid(table, job->pid);
+    if (pid) index_pid(table, pid, job - table->jobs);
+    job->pid = pid;
 }
 
-static void insertHeap(ProcessHeap h, Process new){
-    // remember: assertions should be disabled by gcc in production.
-    assert(h);
-    assert(POLICY_REAL_TIME(policy(new)));
-	if(h->size + 1 < MAX_RTIME){
-        int index = searchProcess(h, new); // if -1 the heap is empty
-        if (index < 0)
-            h->node[0] = new;
-        else {
-            // notice this gives us worst case O(n^2).
-            for (int i = h->size; i > index; i--) 
-                h->node[i] = h->node[i - 1];
-            h->node[index] = new;
-        }
-		h->size += 1;
-        h->time_used += DTIME(new);
-	} 
-    else handle("not enough space in buffer to add REAL-TIME process at %s to the process table\n", path(new));
+// Gets the job of a handle, or NULL if the handle is stale.
+static struct job* get_job(ProcessTable table, JobHandle handle){
+    if (handle == NO_JOB) return NULL;
+    unsigned int index = JOB_INDEX(handle);
+    if (index >= table->nr_jobs) return NULL;
+    struct job* job = &table->jobs[index];
+    if (!job->p || JOB_HANDLE(index, job->generation) != handle) return NULL;
+    return job;
 }
 
-// frees processes
-static void freeHeap(ProcessHeap h){
-    if(!h || !h->size) return;
-    for (int i = 0; i < h->size; i++) free_process(h->node[i]);
-    free(h);
-}
-
-// time limits as percentages that each priority queue is allowed to occupy of the total CPU time. 
-// sums 95.5, 0.5 seconds is used to run a single round robin process at a time.
-// static const float priority_time_limits[8] = {36.7, 18.3, 12.1, 9.0, 7.2, 6.2, 5.3, 4.7};
-
-typedef rax* PathTrie;
-
-struct process_table{
-    // absolute path name lookup radix trie for REAL-TIME processes.
-    PathTrie absolute;
-    // relative path name lookup radix trie for REAL-TIME processes.
-    PathTrie relative;
-    // array for storing REAL-TIME processes.
-    ProcessHeap real_time;
-
-    // uses 8 bits to verify for each priority level whether processes in it can run or not.
-    // least significant bit used for 0 priority.
-    char priority_runnable;
-    // queues of priority based processes.
-    ProcessQueue levels[PRIOR_LEVELS];
-    // amount of maximum time each priority level is allowed to run;
-    float priority_time_limits[PRIOR_LEVELS];
-    // a weighted sum used to calculate priority_time_limits.
-    float priority_total;
-    // flag decides whether to run round robin or priority.
-    char run_priority;
-
-    // queue of round robin based processes.
-    ProcessQueue robin; 
-    // time in milliseconds ranging in [0-4095] that each round robin process should be allowed to run.
-    unsigned short quantum;
-};
-
-
-
-// creates empty process table
-ProcessTable create_table(){
-    ProcessTable new = (ProcessTable) malloc(sizeof(struct process_table));
-    if (!new) handle("no memory to create process table\n");
-    new->absolute = NULL;
-    new->relative = NULL;
-    new->real_time = NULL;
-
-    new->priority_runnable = 0xFF; // sets all bits to 1.
-    // make sure there is no garbage in the table which might accidentally evaluate to true.
-    for (char i = 0; i < PRIOR_LEVELS; i++){
-        new->levels[i] = NULL;
-        new->priority_time_limits[i] = 0;
+// gives p a new job, reusing a free one if possible.
+static struct job* new_job(ProcessTable table, Process p){
+    unsigned int index;
+    if (table->free_jobs){
+        index = table->free_jobs - 1;
+        table->free_jobs = table->jobs[index].next_free;
     }
-    new->priority_total = 0.0; // when there are no processes there is no sum.
-    // by default, we expect priority run mode to have precedence, so we set the flag up.
-    new->run_priority = 1;
-
-    new->robin = NULL;
-    new->quantum = QUANTUM;
-    return new;
-}
-
-// frees the process table
-void free_table(ProcessTable table){
-    // I think by now there is no need to remind the reader that assertions should be disabled in production.
-    assert(table);
-    // raxFree wont free the processes, 
-    // but that is alright since they are referenced in the heap,
-    // so we can free them when we free the heap.
-    // There is a rax routine to free the processes, but if we did that
-    // there would be dangling pointers when we tried to free the heap,
-    // and this might cause undefined behaviour.
-    if(table->absolute)  raxFree(table->absolute);
-    if(table->relative)  raxFree(table->relative);
-    if(table->real_time) freeHeap(table->real_time);
-
-    for (uint8_t i = 0; i < PRIOR_LEVELS; i++)
-        if(table->levels[i]) freeQueue(table->levels[i]);
-    
-    if(table->robin) freeQueue(table->robin);
-    free(table);
+    else {
+        if (table->nr_jobs == table->jobs_size){
+            unsigned int size = table->jobs_size ? table->jobs_size * 2 : 64;
+            if (size > JOB_INDEX((JobHandle) -1)) size = JOB_INDEX((JobHandle) -1);
+            if (table->nr_jobs == size) handle("too many processes in the process table to add the one at %s\n", path(p));
+            struct job* jobs = (struct job*) realloc(table->jobs, size * sizeof(struct job));
+            if (!jobs) handle("no memory to keep the job of process at %s\n", path(p));
+            table->jobs = jobs;
+            table->jobs_size = size;
+        }
+        index = table->nr_jobs++;
+        table->jobs[index].generation = 0;
+    }
+    struct job* job = &table->jobs[index];
+    job->p = p;
+    job->node = NULL;
+    job->pid = 0;
+    set_handle(p, JOB_HANDLE(index, job->generation));
+    reindex_job(table, job);
+    return job;
 }
 
-// checks the runnable mask for whether a given priority level can run.
-static char runnable(ProcessTable table, unsigned char priority){
-    return (table->priority_runnable >> priority) & 1;
+static void free_job(ProcessTable table, struct job* job){
+    set_handle(job->p, NO_JOB);
+    job->p = NULL;
+    reindex_job(table, job);
+    job->generation = (job->generation + 1) & JOB_GENERATION_MASK;
+    job->next_free = table->free_jobs;
+    table->free_jobs = job - table->jobs + 1;
 }
 
-// flips the runnable flag of a priority level.
-static void flip_runnable(ProcessTable table, unsigned char priority){
-    table->priority_runnable ^= 1 << priority;
+// Gets the slot of the job of p where its class may keep the node of p in the run queue.
+void** job_node(ProcessTable table, Process p){
+    struct job* job = get_job(table, get_handle(p));
+    assert(job && job->p == p);
+    return &job->node;
 }
 
-// decides whether a priority level is allowed to run or not.
-// if it cant, it is set as not runnable, and run times for priority queues are cleared.
-static void can_run(ProcessTable table, unsigned char priority){
-    assert(table);
-    assert(priority < PRIOR_LEVELS);
-    assert(table->levels[priority]);
-    
-    // time avaible for priority and round robin processes, in seconds.
-    char time_avail = 60 - (table->real_time ? table->real_time->time_used : 0);
-    
-    // time avaible for the given priority level.
-    float priority_time = table->priority_time_limits[priority] * PRIORITY_TIME * time_avail;
-
-    // if the time the priority level has run is greater than the avaible time, it should not continue
-    // to run until the next minute.
-    if ((table->levels[priority]->time_run / 1000.0) > priority_time){
-        if (runnable(table, priority)) flip_runnable(table, priority);
-        table->levels[priority]->time_run = 0;
+// slot of the class which runs processes with the given policy.
+static unsigned char class_of(unsigned short pol){
+    switch (PLP(pol)){
+        case REAL_TIME: return CLASS_REAL_TIME;
+        case PRIORITY: return CLASS_PRIORITY;
+        default: return CLASS_ROUND_ROBIN;
     }
 }
 
-// marks a REAL-TIME process as having already run this minute.
-// If the process is not in the table, undefined behaviour occurs.
-void setRan (ProcessTable table, Process p){
-    table->real_time->ran[searchProcess(table->real_time, p)] = 1;
-}
-
-// checks whether a REAL-TIME process has already run this minute.
-// If the process is not in the table, undefined behaviour occurs.
-char getRan (ProcessTable table, Process p){
-    return table->real_time->ran[searchProcess(table->real_time, p)];
-}
-
 // Inserts new process in the process table.
 // Return 1 if the addition should cause the added process to be immediatly executed (preemption),
 // and -1 if the process couldn't be added, otherwise 0.
 // The cur_policy is the policy of the currently running process, or O if there isn't any.
 // The cur_time parameter gives the current time in seconds since the beggining of the minute.
 // Both arguments are used to determine if preemption occurs.
-// The time_run_last parameter should tell how long the added process ran for last time it was executed. 
+// The time_run_last parameter should tell how long the added process ran for last time it was executed.
 // If it hasn't been executed yet, it should be set to 0.
 char insertProcess(ProcessTable table, Process p, unsigned short cur_policy, unsigned char cur_time, unsigned int time_run_last){
     assert(table && p); // off in production
     assert(cur_policy ? !validate_policy(cur_policy) : 1);
     assert(cur_time <= 60);
-    unsigned short pol = policy(p);
-    char preemption = 0;
-    char priority;
-    switch (PLP(pol)){
-        case REAL_TIME: 
-            if (!table->real_time) table->real_time = createHeap();
-
-            // lets obtain the process path here for later convenience.
-            char *s = path(p);
-
-            // First we must figure out whether the added process makes reference to another
-            // process or not. If it does, we should resolve the reference that the start time of 
-            // the added process matches the end time of the process it makes reference to.
-            // This way our scheduling algorithm can treat an Ipath process rougly the same way as a normal process.
-            if (POLICY_MAKES_REFERENCE(pol)){
-                char* ipath = Ipath(p);
-                // find the referenced process in the path tries.
-                void* reference = raxFind(*ipath == '/' ? table->absolute : table->relative, ipath, strlen(ipath));
-                if (reference == raxNotFound){
-                    fprintf(stderr, "Process to be added at %s makes reference to a non existent process.\n", s);
-                    fprintf(stderr, "Non existent process was supposed to be at %s\n", ipath);
-                    fprintf(stderr, "The added process will not be executed.\n");
-                    return -1;
-                }
-                //sets this processes's start time to the end time of the referenced process.
-                else {
-                    resolve(p, ETIME((Process) reference));
-                    pol = policy(p);
-                }
-            }
-
-            // Now we must check whether this process conflicts with other processes in the heap.
-            int pos = searchProcess(table->real_time, p);
-            // check compatibility with previous process, if there is one.
-            if (pos > 0 && ETIME(table->real_time->node[pos - 1]) > GET_I(pol)){
-                fprintf(stderr, "Process to be added at %s conflicts with previous process.\n", s);
-                fprintf(stderr, "The added process will not be executed.\n");
-                return -1;
-            }
-            
-            // check compatibility with next process, if there is one.
-            if (pos < table->real_time->size - 1 && STIME(table->real_time->node[pos]) < PETIME(pol)){
-                fprintf(stderr, "Process to be added at %s conflicts with subsequent process.\n", s);
-                fprintf(stderr, "The added process will not be executed.\n");
-                return -1;
-            }
-
-            // Next we check whether the process path is relative or absolute, and add it to the respective trie.
-            if(*s == '/') {
-                if (!table->absolute) {
-                    table->absolute = raxNew();
-                    if(!table->absolute) 
-                        handle("no memory to allocate area to keep absolute path names of program files.\n");
-                }
-                if(!raxTryInsert(table->absolute, s, strlen(s), p, NULL)){
-                    fprintf(stderr, "Process already exists at %s\n", s);
-                    fprintf(stderr, "Since only one process per location is accepted, the added process will not be executed.\n");
-                    return -1;
-                }
-            }
-            else{
-                if (!table->relative) {
-                    table->relative = raxNew();
-                    if(!table->relative) 
-                        handle("no memory to allocate area to keep relative path names of program files.\n");
-                }
-                if(!raxTryInsert(table->relative, s, strlen(s), p, NULL)){
-                    fprintf(stderr, "Process already exists at %s\n", s);
-                    fprintf(stderr, "Since only one process per location is accepted, the added process will not be executed.\n");
-                    return -1;
-                }
-            }
-            
-            // finally we insert the process in the process heap.
-            insertHeap(table->real_time, p);
-
-            // We must now figure out whether preemption should occur or not.
-            // If there is no process currently running, it should not.
-            if (!cur_policy) return 0;
-
-
-            // If the current process is REAL-TIME preemption should only occur
-            // if the current process should already have ended or is about to end in the current time,
-            // and if the added process should be run immediately after the current process,
-            // i.e. if the end time of the current process matches the start time of this process.
-            // Otherwise, if the current process is not REAL-TIME, preemption should occur whenever the
-            // time is right.
-            if (POLICY_REAL_TIME(cur_policy)){
-                char end_time = PETIME(cur_policy);
-                preemption = (end_time == GET_I(pol)) && cur_time >= end_time;
-            }
-            else 
-                preemption = cur_time >= GET_I(pol);
-
-            break;
-        case ROUND_ROBIN:
-            if (!table->robin) table->robin = createQueue();
-            insertQueue(table->robin, p, time_run_last); // add process to queue
-            //check if quantum should be updated.
-            unsigned short quantum = GET_QUANTUM(pol);
-            if(quantum) table->quantum = quantum;
-            // no preemption should occur in favour of a ROUND-ROBIN process.
-            break;
-        case PRIORITY:
-            priority = GET_PRIORITY(pol);
-            if (!table->levels[priority]) table->levels[priority] = createQueue();
-            
-            // if the level is empty it is not being counted in the weighted sum,
-            // so since we are adding a process to it, it should now start counting.
-            if (queueEmpty(table->levels[priority])){
-                // update sum with value inversely proportional to priority level
-                float add = 1.0/(priority + 1);
-                table->priority_total += add;
-                // priority time limits are fractions of the total sum.
-                table->priority_time_limits[priority] = add/table->priority_total;
-            }
-
-            insertQueue(table->levels[priority], p, time_run_last); // add to queue
-
-            // we should determine based on this addition whether the priority level of the added process
-            // has already run enough or can keep running.
-            can_run(table, priority);
-
-
-            // We must now figure out whether preemption should occur or not.
-            // If there is no process currently running, it should not.
-            if (!cur_policy) return 0;
-
-            // preemption should only occur for a process that has not yet run (this minute)
-            // when the current process is also priority based and the added process 
-            // has greater priority then the current one.
-            // It should also be checked whether the priority level of the added process can still keep running
-            preemption = !time_run_last && 
-                         POLICY_PRIORITY(cur_policy) &&
-                         priority > GET_PRIORITY(cur_policy) &&
-                         runnable(table, priority);
-            break;
-    }
-    // We could argue based on the code that
+    unsigned char cls = class_of(policy(p));
+    // a process put back after running keeps its job.
+    struct job* job = get_job(table, get_handle(p));
+    char new = !job || job->p != p;
+    if (new) job = new_job(table, p);
+    // the PID may have been changed with set_pid while the process was running.
+    else reindex_job(table, job);
+    // the class is told how long the process ran before it is put back.
+    if (time_run_last)
+        table->classes[cls]->tick(table, table->queues[cls], p, time_run_last);
+    // We could argue based on the code of the classes that
     // if cur_policy is the policy of the added process, no preemption can ever occur.
-    return preemption;
+    char result = table->classes[cls]->enqueue(table, table->queues[cls], p, cur_policy, cur_time, time_run_last);
+    if (result < 0 && new) free_job(table, get_job(table, get_handle(p)));
+    return result;
 }
 
-// This internal function tells what process should run next on the assumption it is not
-// a REAL-TIME process. See next_process below for details.
-// This function was created to allow a recursive call to be made.
-static Process case_no_real_time(ProcessTable table){
-    // In case the next process is not REAL-TIME, 
-    // to know its execution policy we simply have to check the specific flag for it.
-    if (table->run_priority){
-
-        // We figure out which priority level should be run by taking
-        // the level with the greatest priority which is runnable and not empty.
-        ProcessQueue level = NULL;
-        unsigned char priority;
-        for (priority = 0; priority < PRIOR_LEVELS; priority++){
-            level = table->levels[priority];
-            if (level && !queueEmpty(level) && runnable(table, priority))
-                break;
-            else level = NULL;
-        }
-        
-        // Supposing no processes can run at all, we should give a chance for 
-        // ROUND-ROBIN processes to run. 
-        // So we wrap the rest of the code in an IF statement.
-        if (level){
-            // We pop the first process off the level queue.
-            Process to_run = popQueue(level);
-
-            // Since we popped a process, we need to figure out whether this casused
-            // the queue to be made empty. In that case we need to update the total weighted sum.
-            if (queueEmpty(level)){
-                float subtract = 1.0/(priority + 1);
-                table->priority_total -= subtract;
-                table->priority_time_limits[priority] = 0.0;
-            }
-            
-            // We also update the run_priority flag for the next execution.
-            table->run_priority = 0;
-
-            // finally just return
-            return to_run;
-        }
+// Inserts n processes in the process table at once.
+char insertProcesses(ProcessTable table, Process* ps, unsigned int n, char* status, unsigned short cur_policy, unsigned char cur_time){
+    assert(table && (ps || !n) && (status || !n));
+    assert(cur_policy ? !validate_policy(cur_policy) : 1);
+    assert(cur_time <= 60);
+    char preempt = 0;
+    unsigned int i;
+
+    // processes are grouped by class, keeping their order, and given jobs.
+    unsigned int count[NR_CLASSES + 1] = {0};
+    for (i = 0; i < n; i++){
+        assert(ps[i]);
+        count[class_of(policy(ps[i])) + 1]++;
+        struct job* job = get_job(table, get_handle(ps[i]));
+        if (!job || job->p != ps[i]) new_job(table, ps[i]);
+    }
+    for (i = 1; i <= NR_CLASSES; i++) count[i] += count[i - 1];
+    unsigned int* index = (unsigned int*) malloc(n * sizeof(unsigned int));
+    Process* grouped = (Process*) malloc(n * sizeof(Process));
+    char* result = (char*) malloc(n);
+    if (n && (!index || !grouped || !result)) handle("no memory to add %d processes to the process table\n", n);
+    for (i = 0; i < n; i++){
+        unsigned int to = count[class_of(policy(ps[i]))]++;
+        index[to] = i;
+        grouped[to] = ps[i];
     }
 
-    // Here, if the function hasn't returned, we handle the ROUND-ROBIN case.
-    ProcessQueue robin = table->robin;
+    // count[cls] is now the end of the group of the class.
+    unsigned int start = 0;
+    for (unsigned char cls = 0; cls < NR_CLASSES; start = count[cls++]){
+        if (start == count[cls]) continue;
+        SchedClass class = table->classes[cls];
+        if (class->enqueue_many)
+            preempt |= class->enqueue_many(table, table->queues[cls], grouped + start, count[cls] - start, result + start, cur_policy, cur_time);
+        else for (i = start; i < count[cls]; i++){
+            result[i] = class->enqueue(table, table->queues[cls], grouped[i], cur_policy, cur_time, 0);
+            if (result[i] > 0) preempt = 1;
+        }
+    }
 
-    // First we check whether there are processes to run.
-    // If there aren't any and it is the proper turn to run ROUND-ROBIN processes,
-    // then we should allow priority processes to run instead.
-    // But if it was actually the turn  of priority processes and there weren't any to run,
-    // then there are no processes to run at all, and we should just return NULL.
-    // This is checked with the run_priority flag.
-    // If NULL is returned it will always be the turn of priority processes next.
-    if (!robin || queueEmpty(robin)){
-        if (table->run_priority) 
-            return NULL; // nothing can run
-        // here we know that it is ROUND-ROBIN's turn, so we change the turn.
-        table->run_priority = 1;
-        return case_no_real_time(table);
+    for (i = 0; i < n; i++){
+        status[index[i]] = result[i];
+        // processes which couldn't be added don't keep their jobs.
+        if (result[i] < 0) free_job(table, get_job(table, get_handle(grouped[i])));
     }
+    free(index);
+    free(grouped);
+    free(result);
+    return preempt;
+}
 
-    // If there are processes, it is just a matter of popping one from the queue
-    return popQueue(robin);
+// Gets the process of a job, or NULL if the handle is stale.
+Process find_job(ProcessTable table, JobHandle job){
+    assert(table);
+    struct job* found = get_job(table, job);
+    return found ? found->p : NULL;
+}
+
+// Removes a job from the table, without freeing its process.
+Process removeProcess(ProcessTable table, JobHandle job){
+    assert(table);
+    struct job* found = get_job(table, job);
+    if (!found) return NULL;
+    Process p = found->p;
+    unsigned char cls = class_of(policy(p));
+    table->classes[cls]->dequeue(table, table->queues[cls], p);
+    free_job(table, found);
+    return p;
+}
+
+// Changes the policy of a job in place.
+char change_policy(ProcessTable table, JobHandle job, unsigned short new_policy, unsigned short cur_policy, unsigned char cur_time){
+    assert(table);
+    assert(cur_policy ? !validate_policy(cur_policy) : 1);
+    Process p = find_job(table, job);
+    if (!p || validate_policy(new_policy)) return -1;
+    // see set_policy for these.
+    if (POLICY_MAKES_REFERENCE(new_policy) != POLICY_MAKES_REFERENCE(policy(p))) return -1;
+    if (placeable(p) && POLICY_REAL_TIME(new_policy) && window_start(p) + GET_D(new_policy) > window_end(p)) return -1;
+
+    unsigned char from = class_of(policy(p));
+    unsigned char to = class_of(new_policy);
+    if (from == to)
+        return table->classes[to]->change(table, table->queues[to], p, new_policy, cur_policy, cur_time);
+
+    // Otherwise the process moves to the run queue of its new class.
+    // A process which is running is moved when it is put back, unless it becomes REAL-TIME,
+    // since REAL-TIME processes stay in their run queue while they run.
+    unsigned short old_policy = policy(p);
+    char queued = table->classes[from]->dequeue(table, table->queues[from], p);
+    set_policy(p, new_policy);
+    if (!queued && to != CLASS_REAL_TIME) return 0;
+    char result = table->classes[to]->enqueue(table, table->queues[to], p, cur_policy, cur_time, 0);
+    if (result >= 0) return result;
+
+    // if it doesn't fit its new class the process goes back where it was.
+    set_policy(p, old_policy);
+    if (queued) table->classes[from]->enqueue(table, table->queues[from], p, 0, cur_time, 0);
+    return -1;
+}
+
+// Gets the process in the table with the given PID.
+Process find_pid(ProcessTable table, int pid){
+    assert(table);
+    if (pid <= 0 || !table->nr_pids) return NULL;
+    struct pid_slot* slot = &table->pids[pid_slot(table, pid)];
+    return slot->pid ? table->jobs[slot->job].p : NULL;
+}
+
+// Changes the PID of a process in the table, keeping the PID index up to date.
+void table_set_pid(ProcessTable table, Process p, int pid){
+    assert(table && p);
+    set_pid(p, pid);
+    struct job* job = get_job(table, get_handle(p));
+    if (job && job->p == p) reindex_job(table, job);
+}
+
+// Removes a job from the table and frees its process.
+char cancelProcess(ProcessTable table, JobHandle job){
+    Process p = removeProcess(table, job);
+    if (!p) return 0;
+    free_process(p);
+    return 1;
 }
 
 // The very soul of the scheduler.
@@ -529,88 +384,41 @@ static Process case_no_real_time(ProcessTable table){
 Process next_process(ProcessTable table, unsigned char cur_time){
     assert(table);
 
-    // First we need to determine the policy of the next process.
-    // To do this we check first whether it is REAL-TIME or not, 
-    // if it isn't will be really easy to determine its policy then.
-
-    // figure out the position close to which the REAL-TIME process to run would be.
-    int pos = bin_search(table->real_time, cur_time);
-    
-    // In case pos returns negative, there are no REAL-TIME processes to run.
-    // So we check that.
-    if (pos >= 0){
-
-        // If the position is out of bounds, 
-        // then only the last process may possibly be allowed to run.
-        // So we handle that case.
-        if(pos >= table->real_time->size){
-            Process cur = table->real_time->node[table->real_time->size - 1];
-            char cur_ran = table->real_time->ran[table->real_time->size - 1];
-            if (cur_time < ETIME(cur) && !cur_ran) return cur;
-        }
-        else {
-            // get previous and current process
-            Process prev = pos > 0 ? table->real_time->node[pos - 1] : NULL;
-            char prev_ran = pos > 0 ? table->real_time->ran[pos - 1] : 0;
-            Process cur = table->real_time->node[pos];
-            char cur_ran = table->real_time->ran[pos];
-
-            // Now we know that start time of prev < cur_time 
-
-            // So we check first if the end time of prev is already up, 
-            // if it isn't, and the process has not yet run its course,
-            // we should simply return prev to run
-            if (prev && !prev_ran && ETIME(prev) > cur_time)
-                return prev;
-
-            // To see if it is cur that has to run, suffices to check
-            // whether cur_time is in betwen the start time of cur
-            // inclusive, and the end time of cur, exclusive.
-            // If cur_time is less than the start time 
-            // there will be a least 1 second of difference between them,
-            // and the scheduler can run a lot of processes in one second.
-            // However, if the ran flag is set for cur, we should really be executing
-            // the next process if one is avaiable.
-            if (STIME(cur) <= cur_time && cur_time < ETIME(cur)){
-                if (!cur_ran) return cur;
-                return next_process(table, ETIME(cur));
-            }
-
-            // However, we should also check the case cur MAKES_REFERENCE to prev, in which case,
-            // if prev has already run, we should allow cur to run immediately, unless cur_ran is set.
-            if (PMR(cur) && prev_ran){
-                if (!cur_ran) return cur;
-                if (cur_time < ETIME(cur)) return next_process(table, ETIME(cur));
-            }
+    // REAL-TIME processes have precedence whenever it is their time to run.
+    Process to_run = table->classes[CLASS_REAL_TIME]->pick_next(table, table->queues[CLASS_REAL_TIME], cur_time);
+    if (to_run) return to_run;
+
+    // Otherwise the other classes take turns, starting with the class whose turn it is.
+    // If it has no process to run, the next class gets the chance to run instead.
+    for (unsigned char i = 0; i < NR_CLASSES - FIRST_BEST_EFFORT; i++){
+        unsigned char cls = FIRST_BEST_EFFORT + (table->turn - FIRST_BEST_EFFORT + i) % (NR_CLASSES - FIRST_BEST_EFFORT);
+        to_run = table->classes[cls]->pick_next(table, table->queues[cls], cur_time);
+        if (to_run){
+            // the turn passes on to the next class.
+            table->turn = FIRST_BEST_EFFORT + (cls - FIRST_BEST_EFFORT + 1) % (NR_CLASSES - FIRST_BEST_EFFORT);
+            return to_run;
         }
     }
 
-    // If the process to run is neither prev nor cur, it must have some other execution policy.
-    // We created a helper function for this case, so we simply call it.
-    return case_no_real_time(table);
+    // If NULL is returned it will always be the turn of priority processes next.
+    table->turn = FIRST_BEST_EFFORT;
+    return NULL;
+}
+
+// Gets the time in milliseconds the process chosen by next_process at cur_time
+// should be allowed to run before the next context switch.
+unsigned int time_slice(ProcessTable table, Process p, unsigned char cur_time){
+    assert(table && p);
+    unsigned char cls = class_of(policy(p));
+    return table->classes[cls]->slice_for(table, table->queues[cls], p, cur_time);
 }
 
 // Resets information associated with the process table for the next minute execution.
 // This routine should be called every 60 seconds.
 void reset(ProcessTable table){
     assert(table);
-    uint16_t i;
-    
-    // Mark all REAL-TIME processes as not run.
-    if (table->real_time)
-        for (i = 0; i < MAX_RTIME; i++)
-            table->real_time->ran[i] = 0;
-            
-    // Reset time run for priority processes.
-    for (i = 0; i < PRIOR_LEVELS; i++)
-        if (table->levels[i]) 
-            table->levels[i]->time_run = 0;
-
-    // All levels are now allowed to run.
-    table->priority_runnable = 0xFF;
-
-    // Reset time run for ROUND-ROBIN processes.
-    if (table->robin) table->robin->time_run = 0;
+    for (unsigned char i = 0; i < NR_CLASSES; i++)
+        table->classes[i]->reset_period(table->queues[i]);
 }
 
 // Prints out the whole current state of the process table.
@@ -619,154 +427,30 @@ void table_show(ProcessTable table){
         puts("\nTHERE IS NO TABLE TO PRINT.");
         return;
     }
-    
-    Process cur;
-    ProcessQueue level;
-    char cur_ran;
-    unsigned char numlevels;
-    unsigned char blocked_levels;
-    unsigned char active_levels;
-    unsigned char empty_levels;
-    unsigned int total_priority_time;
-    char robin_full;
-    char real_time_full;
-    int i;
-    Node process;
-
-    // figure out number of total, active, empty and blocked levels.
-    numlevels = 0;
-    blocked_levels = 0;
-    total_priority_time = 0;
-    for (i = 0; i < PRIOR_LEVELS; i++){
-        level = table->levels[i];
-        if  (level && !queueEmpty(level)){
-            numlevels++;
-            total_priority_time += level->time_run;
-            if (!runnable(table, i)) blocked_levels++;
-        } 
-    }
-    active_levels = numlevels - blocked_levels;
-    empty_levels = PRIOR_LEVELS - numlevels;
-
-    // check whether there are ROUND-ROBIN processes.
-    robin_full = table->robin && !queueEmpty(table->robin);
-
-    // check whether there are REAL-TIME processes.
-    real_time_full = table->real_time && table->real_time->size;
 
     // Prints out general information about the table.
     puts("\nPROCESS TABLE:");
-    printf("Quantum: %d milliseconds.\n", table->quantum);
-    printf("Run precedence: %s.\n", table->run_priority ? "PRIORITY" : "ROUND-ROBIN");
+    printf("Quantum: %d milliseconds.\n", getQuantum(table));
+    printf("Run precedence: %s.\n", table->classes[table->turn]->name);
     printf("\n");
 
-    // Print REAL-TIME processes.
-    if (real_time_full){
-        puts("\tREAL-TIME PROCESSES:");
-        printf("\tTotal time allocated: %d.\n", table->real_time->time_used);
-
+    // Then each class prints its processes.
+    for (unsigned char i = 0; i < NR_CLASSES; i++){
+        table->classes[i]->dump(table->queues[i]);
         printf("\n");
-
-        for (i = 0; i < table->real_time->size; i++){
-            cur = table->real_time->node[i];
-            cur_ran = table->real_time->ran[i];
-
-            print_process(cur);
-
-            if (cur_ran)
-                printf("\t\tand has already run this minute.\n");
-            else
-                printf("\t\tand has not yet run this minute.\n");
-
-            printf("\n");
-        }
-    }
-    else
-        printf("\tNo REAL-TIME processes.\n\n");
-
-    // Print PRIORITY based processes.
-    if (numlevels){
-        puts("\tPRIORITY BASED PROCESSES:");
-        printf("\tTotal time used: %d milliseconds.\n", total_priority_time);
-        printf("\tActive levels: %d.\n", active_levels);
-        printf("\tBlocked levels: %d.\n", blocked_levels);
-        printf("\tEmpty levels: %d.\n", empty_levels);
-        printf("\n");
-
-        for (i = 0; i < PRIOR_LEVELS; i++){
-            level = table->levels[i];
-            if (level && !queueEmpty(level)){
-                printf("\tPRIORITY LEVEL %d.\n", i);
-                printf("\tStatus: %s.\n", runnable(table, i) ? "ACTIVE" : "BLOCKED");
-                printf("\n");
-                for (process = level->head; process; process = process->next){
-                    cur = process->p;
-                    print_process(cur);
-                    printf(".\n");
-                }
-                printf("\tTime run: %d.\n", level->time_run);
-                printf("\n");
-            }
-        }
     }
-    else
-        printf("\tNo PRIORITY based processes.\n");
-    
-    printf("\n");
 
-    // Print ROUND-ROBIN processes.
-    if (robin_full){
-        puts("\tROUND-ROBIN PROCESSES:");
-        printf("\tTotal time used: %d milliseconds.\n", table->robin->time_run);
-
-        for (process = table->robin->head; process; process = process->next){
-            printf("\n");
-            cur = process->p;
-            print_process(cur);
-        }
-    }
-    else
-        printf("\tNo ROUND-ROBIN processes.\n");
-    
-    puts("\nEND TABLE");
-    
+    puts("END TABLE");
 }
 
 // Gets the current time quantum for round robin processes.
 unsigned short getQuantum(ProcessTable table){
-    return table->quantum;
+    return robin_quantum(table->queues[CLASS_ROUND_ROBIN]);
 }
 
-// gets time in seconds until the next REAL-TIME process is supposed to run.
-// return -1 if there is no next process.
-char time_to_next_real_time(ProcessTable table, unsigned char cur_time){
-    assert(table);
-
-    // figure out the position close to which the REAL-TIME process to run would be.
-    int pos = bin_search(table->real_time, cur_time);
-    
-    // In case pos returns negative, there are no REAL-TIME processes to run.
-    if (pos < 0) return -1;
-
-    // If the position is out of bounds,
-    // there is no next process
-    if (pos >= table->real_time->size) return -1;
-
-    Process cur = table->real_time->node[pos];
-    char cur_ran = table->real_time->ran[pos];
-
-    // get supposed time
-    char time = STIME(cur) - cur_time;
-
-    if (time > 0) {
-        if (!cur_ran) return time;
-        else return time + DTIME(cur) + time_to_next_real_time(table, ETIME(cur));
-    }
-    
-    // if time is 0, this means the current process to run is cur,
-    // so what we want is actually the process after that.
-    if (time == 0) 
-        return DTIME(cur) + time_to_next_real_time(table, ETIME(cur));
-
-    return -1;
-}
\ No newline at end of file
+// Gets the time slice in milliseconds for PRIORITY based processes of a FAIR_PRIORITY table.
+// Returns 0 if the table runs STRICT_PRIORITY.
+unsigned short getFairSlice(ProcessTable table){
+    if (table->classes[CLASS_PRIORITY] != &fair_sched) return 0;
+    return fair_slice(table->queues[CLASS_PRIORITY]);
+}
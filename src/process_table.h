@@ -11,11 +11,25 @@
 // Default quantum value in milliseconds
 #define QUANTUM 500 // default quantum is 0.5 secs.
 
+// Implementations of the PRIORITY class a table can run.
+// Strict precedence of lower levels over higher ones, each level capped to a share of every minute.
+#define STRICT_PRIORITY 0
+// Weighted fair sharing, where every level receives CPU time inversely proportional to its number.
+#define FAIR_PRIORITY 1
+// Period in milliseconds in which every process of the fair class should get to run once.
+#define FAIR_LATENCY 6000
+// Smallest time slice in milliseconds handed out by the fair class.
+#define FAIR_MIN_SLICE 100
+
 typedef struct process_table* ProcessTable;
 
 // creates empty process table
 ProcessTable create_table();
 
+// creates empty process table which runs the given implementation of the PRIORITY class,
+// either STRICT_PRIORITY or FAIR_PRIORITY. create_table uses STRICT_PRIORITY.
+ProcessTable create_table_with_class(char priority_class);
+
 // frees the process table
 void free_table(ProcessTable table);
 
@@ -27,6 +41,20 @@ void setRan (ProcessTable table, Process p);
 // If the process is not in the table, undefined behaviour occurs.
 char getRan (ProcessTable table, Process p);
 
+// marks a REAL-TIME process as having already run this minute,
+// after it ran for time_ran milliseconds, i.e. it exited, blocked or used up its D time.
+// What it didn't use of its reservation is reclaimed as slack, which PRIORITY and
+// ROUND-ROBIN processes can run in until the next REAL-TIME process starts,
+// unless the next REAL-TIME process makes reference to it and so starts right away.
+// If the process is not in the table, undefined behaviour occurs.
+void releaseRealTime(ProcessTable table, Process p, unsigned int time_ran);
+
+// Gets how many milliseconds of slack were reclaimed from REAL-TIME processes this minute.
+unsigned int getSlack(ProcessTable table);
+
+// Gets how many milliseconds of slack were reclaimed since the table was created.
+unsigned long long getTotalSlack(ProcessTable table);
+
 // Inserts new process in the process table.
 // Return 1 if the addition should cause the added process to be immediatly executed (preemption),
 // and -1 if the process couldn't be added, otherwise 0.
@@ -35,8 +63,58 @@ char getRan (ProcessTable table, Process p);
 // Both arguments are used to determine if preemption occurs.
 // The time_run_last parameter should tell how long the added process ran for last time it was executed. 
 // If it hasn't been executed yet, it should be set to 0.
+// A REAL-TIME process created with a window is placed in the earliest free interval of its window,
+// and its start time can then be read with STIME.
+// A REAL-TIME process which makes reference to processes not yet in the table is accepted (0 is returned),
+// but only runs once all of them are added; see Ipath in shared_defs.h.
 char insertProcess(ProcessTable table, Process p, unsigned short cur_policy, unsigned char cur_time, unsigned int time_run_last);
 
+// Inserts n processes in the process table at once, as if each one was inserted with insertProcess
+// having not been executed yet, but much faster for large batches of REAL-TIME processes,
+// which are sorted once and merged with the ones already in the table.
+// The result insertProcess would have given for each process is written to the same position of status.
+// Returns 1 if the addition of any of them should cause preemption, otherwise 0.
+char insertProcesses(ProcessTable table, Process* ps, unsigned int n, char* status, unsigned short cur_policy, unsigned char cur_time);
+
+// Jobs.
+// Every process added to the table is given a job, whose handle can be read with get_handle
+// (see shared_defs.h) and stays valid until the process is removed from the table,
+// even while the process was picked by next_process and is running.
+// Once a job is removed its handle is stale, and it is not mistaken for the handle of a later job
+// unless the job is reused more than a thousand times.
+
+// Gets the process of a job, or NULL if the handle is stale.
+Process find_job(ProcessTable table, JobHandle job);
+
+// Removes a job from the table, returning its process without freeing it,
+// or NULL if the handle is stale.
+// Processes which make reference to a removed REAL-TIME process wait until another process is added at its path.
+// A process which was picked by next_process can be removed as well,
+// but then it must not be put back with insertProcess or releaseRealTime.
+Process removeProcess(ProcessTable table, JobHandle job);
+
+// Changes the policy of a job, as with set_policy (see shared_defs.h), without taking it out of the table.
+// PRIORITY and ROUND-ROBIN processes are requeued in O(1), REAL-TIME processes are moved to their new slot
+// and the processes which make reference to them are resolved again.
+// What the class of the job accounted for it, such as its virtual runtime, is kept as long as the class doesn't change.
+// cur_policy and cur_time are as in insertProcess, and the return value follows the same preemption rules,
+// except that -1 is also returned if the handle is stale or the policy is invalid, in which case the job is left as it was.
+// The running process can be moved out of the REAL-TIME class only after it stops running.
+char change_policy(ProcessTable table, JobHandle job, unsigned short new_policy, unsigned short cur_policy, unsigned char cur_time);
+
+// Gets the process in the table with the given PID in O(1), or NULL if there is none.
+// Processes picked by next_process are still found, since they keep their jobs.
+Process find_pid(ProcessTable table, int pid);
+
+// Changes the PID of a process, as set_pid does, keeping the PID index of the table up to date.
+// The PID of a process in a table should always be changed with this instead of set_pid.
+void table_set_pid(ProcessTable table, Process p, int pid);
+
+// Removes a job from the table and frees its process.
+// Returns 0 if the handle is stale.
+// The process currently running should be removed with removeProcess instead, since the caller still holds it.
+char cancelProcess(ProcessTable table, JobHandle job);
+
 // The very soul of the scheduler.
 // This routine determines what process should run next based on the current time.
 // This also removes the chosen process from the table, UNLESS the process is REAL-TIME.
@@ -45,6 +123,10 @@ char insertProcess(ProcessTable table, Process p, unsigned short cur_policy, uns
 // Returns NULL if there are no processes that can be run.
 Process next_process(ProcessTable table, unsigned char cur_time);
 
+// Gets the time in milliseconds the process chosen by next_process at cur_time
+// should be allowed to run before the next context switch.
+unsigned int time_slice(ProcessTable table, Process p, unsigned char cur_time);
+
 // Resets information associated with the process table for the next minute execution.
 // This routine should be called every 60 seconds.
 void reset(ProcessTable table);
@@ -55,6 +137,15 @@ void table_show(ProcessTable table);
 // Gets the current time quantum for round robin processes.
 unsigned short getQuantum(ProcessTable table);
 
+// Gets the time slice in milliseconds for PRIORITY based processes of a FAIR_PRIORITY table.
+// Returns 0 if the table runs STRICT_PRIORITY.
+unsigned short getFairSlice(ProcessTable table);
+
+// Finds the earliest start time at which a REAL-TIME process lasting duration seconds
+// would fit in the window [earliest, latest] of the minute, without conflicting with the
+// REAL-TIME processes already in the table. Returns -1 if there is no such start time.
+char first_free_slot(ProcessTable table, unsigned char duration, unsigned char earliest, unsigned char latest);
+
 // gets time in seconds until the next REAL-TIME process is supposed to run.
 // return -1 if there is no next process.
 char time_to_next_real_time(ProcessTable table, unsigned char cur_time);
\ No newline at end of file
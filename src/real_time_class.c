@@ -0,0 +1,814 @@
+// REAL-TIME scheduling class.
+// REAL-TIME processes run every minute at the second given by their I value,
+// for the number of seconds given by their D value.
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <assert.h>
+#include "sched_class.h"
+#include "rax/rax.h"
+
+// Heap for keeping REAL-TIME processes. It is actually implemented as an ordered array.
+// Ideally I would implement a binary search tree to avoid the costs of using insertion sort 
+// to insert into the heap array, or use a more sophisticated online sorting algorithm than insertion
+// and still mantain the array based implementation. But if I keep thinking about optmizing data structures
+// I am never going to actually finish this project, so insertion sort it is.
+struct process_heap{
+    // the array of processes.
+	Process node[MAX_RTIME];
+
+    // flag tells whether given process ran this minute.
+    char ran[MAX_RTIME];
+
+    // total time in seconds used each 60 seconds for REAL-TIME processes in the heap.
+    char time_used;
+
+    // index of free intervals of the minute: bit s is set if second s is reserved
+    // by some REAL-TIME process. Conflicts and free intervals are found with a few bit operations.
+    uint64_t busy;
+    
+    // size of heap array.
+	int size;
+};
+
+typedef struct process_heap* ProcessHeap;
+
+// bits of the seconds of a minute.
+#define FULL_MINUTE ((((uint64_t) 1) << 60) - 1)
+
+// bits of the seconds in [start, end).
+#define INTERVAL(start, end) ((((uint64_t) 1) << (end)) - (((uint64_t) 1) << (start)))
+
+typedef rax* PathTrie;
+
+// The run queue of the class.
+struct real_time_queue{
+    // absolute path name lookup radix trie for the dependency graph of REAL-TIME processes.
+    PathTrie absolute;
+    // relative path name lookup radix trie for the dependency graph of REAL-TIME processes.
+    PathTrie relative;
+    // array for storing REAL-TIME processes.
+    ProcessHeap real_time;
+    // counter used to mark processes visited in the dependency graph.
+    unsigned int mark;
+
+    // milliseconds of their reservations that REAL-TIME processes left unused this minute,
+    // and which were handed to PRIORITY and ROUND-ROBIN processes.
+    unsigned int slack;
+    // the same, but since the table was created.
+    unsigned long long total_slack;
+};
+
+typedef struct real_time_queue* RealTimeQueue;
+
+static ProcessHeap createHeap(){
+	ProcessHeap new = (ProcessHeap) malloc(sizeof(struct process_heap));
+	if(!new) 
+        handle("no memory to create area for storing information about REAL-TIME processes\n");
+    for (uint16_t i = 0; i < MAX_RTIME; i++)
+        new->ran[i] = 0;
+    new->time_used = 0;
+    new->busy = 0;
+    new->size = 0;
+	return new;
+}
+
+// finds the position in the heap corresponding to the current time.
+// WARNING: May return position out of array bounds.
+static int bin_search(ProcessHeap h, unsigned char time){
+    if (!h || h->size <= 0) return -1;
+    int i = 0;
+    int j = h->size;
+    int m;
+    while (i < j){
+        m = (i + j)/2;
+        if (time > STIME(h->node[m])) i = m + 1;
+        else j = m;
+    }
+    return i;
+}
+
+// finds the position the process should be in the heap, 
+// assuming the heap is ordered by the start time of processes.
+// WARNING: May return position out of array bounds.
+static int searchProcess(ProcessHeap h, Process p){
+    assert(h);
+    assert(p);
+    return bin_search(h, STIME(p));
+}
+
+static void insertHeap(ProcessHeap h, Process new){
+    // remember: assertions should be disabled by gcc in production.
+    assert(h);
+    assert(POLICY_REAL_TIME(policy(new)));
+	if(h->size + 1 < MAX_RTIME){
+        int index = searchProcess(h, new); // if -1 the heap is empty
+        if (index < 0)
+            h->node[0] = new;
+        else {
+            // notice this gives us worst case O(n^2).
+            for (int i = h->size; i > index; i--){
+                h->node[i] = h->node[i - 1];
+                h->ran[i] = h->ran[i - 1];
+            }
+            h->node[index] = new;
+            h->ran[index] = 0;
+        }
+		h->size += 1;
+        h->time_used += DTIME(new);
+        h->busy |= INTERVAL(STIME(new), ETIME(new));
+	} 
+    else handle("not enough space in buffer to add REAL-TIME process at %s to the process table\n", path(new));
+}
+
+// removes the process at index from the heap, without freeing it.
+static void removeHeap(ProcessHeap h, int index){
+    h->time_used -= DTIME(h->node[index]);
+    h->busy &= ~INTERVAL(STIME(h->node[index]), ETIME(h->node[index]));
+    for (int i = index; i < h->size - 1; i++){
+        h->node[i] = h->node[i + 1];
+        h->ran[i] = h->ran[i + 1];
+    }
+    h->size -= 1;
+}
+
+// merges k processes sorted by start time, which conflict with nothing in the heap, into the heap in one pass.
+static void mergeHeap(ProcessHeap h, Process* batch, int k){
+    if (h->size + k >= MAX_RTIME) 
+        handle("not enough space in buffer to add %d REAL-TIME processes to the process table\n", k);
+    // merge from the back so that no process is moved more than once.
+    int i = h->size - 1;
+    int j = k - 1;
+    for (int to = h->size + k - 1; j >= 0; to--){
+        if (i >= 0 && STIME(h->node[i]) > STIME(batch[j])){
+            h->node[to] = h->node[i];
+            h->ran[to] = h->ran[i--];
+        }
+        else {
+            h->node[to] = batch[j--];
+            h->ran[to] = 0;
+            h->time_used += DTIME(h->node[to]);
+            h->busy |= INTERVAL(STIME(h->node[to]), ETIME(h->node[to]));
+        }
+    }
+    h->size += k;
+}
+
+// finds the earliest second in [earliest, latest - duration] from which duration seconds are free.
+// Returns -1 if there is no such interval.
+static char first_fit(ProcessHeap h, unsigned char duration, unsigned char earliest, unsigned char latest){
+    if (!duration || latest > 60 || earliest + duration > latest) return -1;
+
+    // bit s is set if second s is free.
+    uint64_t fits = ~h->busy & FULL_MINUTE;
+
+    // make it so bit s is set if the duration seconds starting at s are free,
+    // doubling the length of the runs checked at each step.
+    unsigned char length = 1;
+    while (length < duration){
+        unsigned char shift = length < duration - length ? length : duration - length;
+        fits &= fits >> shift;
+        length += shift;
+    }
+
+    // only starts inside the window are acceptable.
+    fits &= INTERVAL(earliest, latest - duration + 1);
+    return fits ? __builtin_ctzll(fits) : -1;
+}
+
+// frees processes
+static void freeHeap(ProcessHeap h){
+    if(!h) return;
+    for (int i = 0; i < h->size; i++) free_process(h->node[i]);
+    free(h);
+}
+
+// Dependency graph of REAL-TIME processes.
+// Every path a REAL-TIME process is at, or which some process makes reference to, has a node
+// in the path tries. A process which makes reference to others starts when the last of them ends,
+// and it waits in the graph, out of the heap, until all of them are in the heap.
+// Whenever a process is added, removed or moved, only the processes downstream of it are resolved again.
+
+// edge from a process to a process which makes reference to it.
+struct dependent{
+    struct dependency* node;
+    struct dependent* next;
+};
+
+struct dependency{
+    // the process at the path, or NULL if no process was added there yet,
+    // but some process makes reference to the path.
+    Process p;
+    // whether p is in the heap, i.e. everything it makes reference to was resolved
+    // and it didn't conflict with other processes.
+    char scheduled;
+    // ran flag of p, kept while p is taken out of the heap to be resolved again.
+    char ran;
+    // processes which make reference to this one.
+    struct dependent* dependents;
+
+    // used to visit the processes downstream of a process in topological order.
+    unsigned int mark;
+    struct dependency* next_in_order;
+};
+
+typedef struct dependency* Dependency;
+
+// length of the first path in a list of references.
+static size_t reference_length(const char* ref){
+    const char* end = strchr(ref, REFERENCE_SEPARATOR);
+    return end ? (size_t) (end - ref) : strlen(ref);
+}
+
+// next path in a list of references.
+static const char* next_reference(const char* ref){
+    ref += reference_length(ref);
+    return *ref ? ref + 1 : ref;
+}
+
+static PathTrie* trie_of(RealTimeQueue q, const char* s){
+    // we check whether the path is relative or absolute, and use the respective trie.
+    PathTrie* trie = *s == '/' ? &q->absolute : &q->relative;
+    if (!*trie) {
+        *trie = raxNew();
+        if(!*trie) 
+            handle("no memory to allocate area to keep %s path names of program files.\n", *s == '/' ? "absolute" : "relative");
+    }
+    return trie;
+}
+
+static Dependency find_dependency(RealTimeQueue q, const char* s, size_t len){
+    PathTrie trie = *s == '/' ? q->absolute : q->relative;
+    void* node = trie ? raxFind(trie, (unsigned char*) s, len) : raxNotFound;
+    return node == raxNotFound ? NULL : node;
+}
+
+// finds the node of a path, creating it if it doesn't exist yet.
+static Dependency get_dependency(RealTimeQueue q, const char* s, size_t len){
+    Dependency node = find_dependency(q, s, len);
+    if (node) return node;
+    node = (Dependency) malloc(sizeof(struct dependency));
+    if (!node) handle("no memory to keep the dependencies of REAL-TIME process at %s\n", s);
+    node->p = NULL;
+    node->scheduled = 0;
+    node->ran = 0;
+    node->dependents = NULL;
+    node->mark = 0;
+    node->next_in_order = NULL;
+    raxInsert(*trie_of(q, s), (unsigned char*) s, len, node, NULL);
+    return node;
+}
+
+// removes the node of a path once there is no process at it and no process makes reference to it.
+static void drop_dependency(RealTimeQueue q, const char* s, size_t len, Dependency node){
+    if (node->p || node->dependents) return;
+    raxRemove(*s == '/' ? q->absolute : q->relative, (unsigned char*) s, len, NULL);
+    free(node);
+}
+
+// adds edges from the processes node makes reference to, to node.
+static void link_dependency(RealTimeQueue q, Dependency node){
+    for (const char* ref = Ipath(node->p); *ref; ref = next_reference(ref)){
+        size_t len = reference_length(ref);
+        if (!len) continue;
+        Dependency from = get_dependency(q, ref, len);
+        struct dependent* edge;
+        for (edge = from->dependents; edge && edge->node != node; edge = edge->next);
+        if (edge) continue; // referenced twice.
+        edge = (struct dependent*) malloc(sizeof(struct dependent));
+        if (!edge) handle("no memory to keep the dependencies of REAL-TIME process at %s\n", path(node->p));
+        edge->node = node;
+        edge->next = from->dependents;
+        from->dependents = edge;
+    }
+}
+
+// removes the edges added by link_dependency.
+static void unlink_dependency(RealTimeQueue q, Dependency node){
+    for (const char* ref = Ipath(node->p); *ref; ref = next_reference(ref)){
+        size_t len = reference_length(ref);
+        Dependency from = len ? find_dependency(q, ref, len) : NULL;
+        if (!from) continue;
+        for (struct dependent** edge = &from->dependents; *edge; edge = &(*edge)->next){
+            if ((*edge)->node != node) continue;
+            struct dependent* aux = *edge;
+            *edge = aux->next;
+            free(aux);
+            break;
+        }
+        drop_dependency(q, ref, len, from);
+    }
+}
+
+// start time of a process which makes reference to others: the end time of the last of them.
+// Returns -1 if some of them are not in the heap yet.
+static int resolve_start(RealTimeQueue q, Process p){
+    int start = 0;
+    for (const char* ref = Ipath(p); *ref; ref = next_reference(ref)){
+        size_t len = reference_length(ref);
+        if (!len) continue;
+        Dependency from = find_dependency(q, ref, len);
+        if (!from || !from->scheduled) return -1;
+        if (ETIME(from->p) > start) start = ETIME(from->p);
+    }
+    return start;
+}
+
+// Figures out the start time of p and puts it in the heap.
+// Returns 1 if it was put in the heap, 0 if it must wait for processes it makes reference to,
+// and -1 if it conflicts with other processes.
+static char schedule(RealTimeQueue q, Process p){
+    char *s = path(p);
+
+    // First we must figure out whether the process makes reference to other
+    // processes or not. If it does, we should resolve the reference so that the start time of 
+    // the process matches the end time of the last process it makes reference to.
+    // This way our scheduling algorithm can treat an Ipath process rougly the same way as a normal process.
+    if (PMR(p)){
+        int start = resolve_start(q, p);
+        if (start < 0) return 0;
+        resolve(p, start);
+    }
+
+    // A process which only gave its duration is placed in the earliest free interval of its window.
+    else if (placeable(p)){
+        char start = first_fit(q->real_time, DTIME(p), window_start(p), window_end(p));
+        if (start < 0){
+            fprintf(stderr, "Process to be added at %s fits nowhere in [%d, %d].\n", s, window_start(p), window_end(p));
+            return -1;
+        }
+        place(p, start);
+    }
+
+    // A resolved reference may push the process past the end of the minute.
+    if (ETIME(p) > 60){
+        fprintf(stderr, "Process to be added at %s would run past the end of the minute.\n", s);
+        return -1;
+    }
+
+    // Now we must check whether this process conflicts with other processes in the heap.
+    if (q->real_time->busy & INTERVAL(STIME(p), ETIME(p))){
+        fprintf(stderr, "Process to be added at %s conflicts with another REAL-TIME process.\n", s);
+        return -1;
+    }
+
+    insertHeap(q->real_time, p);
+    return 1;
+}
+
+// takes the process of node out of the heap, remembering whether it ran.
+static void unschedule(RealTimeQueue q, Dependency node){
+    int pos = searchProcess(q->real_time, node->p);
+    node->ran = q->real_time->ran[pos];
+    removeHeap(q->real_time, pos);
+    node->scheduled = 0;
+}
+
+// collects node and the processes downstream of it, so that they end up in topological order.
+static void collect(RealTimeQueue q, Dependency node, Dependency* order){
+    node->mark = q->mark;
+    for (struct dependent* edge = node->dependents; edge; edge = edge->next)
+        if (edge->node->mark != q->mark) collect(q, edge->node, order);
+    node->next_in_order = *order;
+    *order = node;
+}
+
+// Resolves again every process downstream of node, after node was scheduled, unscheduled or moved.
+// All of them are taken out of the heap first, and then put back in topological order,
+// so that each one is resolved only once, after everything it makes reference to.
+// Processes which now conflict wait until something upstream of them changes again.
+static void reschedule(RealTimeQueue q, Dependency node){
+    Dependency order = NULL;
+    Dependency cur;
+    q->mark++;
+    node->mark = q->mark;
+    for (struct dependent* edge = node->dependents; edge; edge = edge->next)
+        if (edge->node->mark != q->mark) collect(q, edge->node, &order);
+
+    for (cur = order; cur; cur = cur->next_in_order){
+        if (cur->scheduled) unschedule(q, cur);
+        else cur->ran = 0;
+    }
+
+    for (cur = order; cur; cur = cur->next_in_order){
+        if (schedule(q, cur->p) <= 0) continue;
+        cur->scheduled = 1;
+        q->real_time->ran[searchProcess(q->real_time, cur->p)] = cur->ran;
+    }
+}
+
+// We must figure out whether preemption should occur or not when p was put in the heap.
+static char preempts(Process p, unsigned short cur_policy, unsigned char cur_time){
+    // If there is no process currently running, it should not.
+    if (!cur_policy) return 0;
+
+    unsigned short pol = policy(p);
+    // If the current process is REAL-TIME preemption should only occur
+    // if the current process should already have ended or is about to end in the current time,
+    // and if the added process should be run immediately after the current process,
+    // i.e. if the end time of the current process matches the start time of this process.
+    // Otherwise, if the current process is not REAL-TIME, preemption should occur whenever the
+    // time is right.
+    if (POLICY_REAL_TIME(cur_policy)){
+        char end_time = PETIME(cur_policy);
+        return (end_time == GET_I(pol)) && cur_time >= end_time;
+    }
+    return cur_time >= GET_I(pol);
+}
+
+static void* create(){
+    RealTimeQueue new = (RealTimeQueue) malloc(sizeof(struct real_time_queue));
+    if (!new) handle("no memory to create area for storing information about REAL-TIME processes\n");
+    new->absolute = NULL;
+    new->relative = NULL;
+    new->real_time = createHeap();
+    new->mark = 0;
+    new->slack = 0;
+    new->total_slack = 0;
+    return new;
+}
+
+// frees the nodes of a trie, and the processes waiting in them.
+static void freeDependencies(PathTrie trie){
+    if (!trie) return;
+    raxIterator it;
+    raxStart(&it, trie);
+    raxSeek(&it, "^", NULL, 0);
+    while (raxNext(&it)){
+        Dependency node = it.data;
+        // processes in the heap are freed along with the heap.
+        if (node->p && !node->scheduled) free_process(node->p);
+        while (node->dependents){
+            struct dependent* aux = node->dependents;
+            node->dependents = aux->next;
+            free(aux);
+        }
+        free(node);
+    }
+    raxStop(&it);
+    raxFree(trie);
+}
+
+static void destroy(void* rq){
+    RealTimeQueue q = rq;
+    freeDependencies(q->absolute);
+    freeDependencies(q->relative);
+    freeHeap(q->real_time);
+    free(q);
+}
+
+static char enqueue(ProcessTable table, void* rq, Process p, unsigned short cur_policy, unsigned char cur_time, unsigned int time_run_last){
+    RealTimeQueue q = rq;
+
+    // lets obtain the process path here for later convenience.
+    char *s = path(p);
+
+    Dependency node = find_dependency(q, s, strlen(s));
+    if (node && node->p){
+        fprintf(stderr, "Process already exists at %s\n", s);
+        fprintf(stderr, "Since only one process per location is accepted, the added process will not be executed.\n");
+        return -1;
+    }
+
+    char scheduled = schedule(q, p);
+    if (scheduled < 0){
+        fprintf(stderr, "The added process will not be executed.\n");
+        return -1;
+    }
+
+    node = get_dependency(q, s, strlen(s));
+    node->p = p;
+    node->scheduled = scheduled;
+    if (PMR(p)) link_dependency(q, node);
+
+    // If the process makes reference to processes which are not in the table yet,
+    // it waits for them to be added.
+    if (!scheduled) return 0;
+
+    // processes which were waiting for this one may now be resolved.
+    reschedule(q, node);
+
+    return preempts(p, cur_policy, cur_time);
+}
+
+// processes which make reference to p go back to waiting for a process at its path.
+static char dequeue(ProcessTable table, void* rq, Process p){
+    RealTimeQueue q = rq;
+    char* s = path(p);
+    Dependency node = find_dependency(q, s, strlen(s));
+    if (!node || node->p != p) return 0;
+    if (node->scheduled) unschedule(q, node);
+    if (PMR(p)) unlink_dependency(q, node);
+    node->p = NULL;
+    reschedule(q, node);
+    drop_dependency(q, s, strlen(s), node);
+    return 1;
+}
+
+// Processes with explicit start times are sorted by start time with a counting sort,
+// checked for conflicts against the heap and each other in a single sweep,
+// and merged into the heap at once. The others depend on where those end up,
+// so they go through enqueue afterwards.
+static char enqueue_many(ProcessTable table, void* rq, Process* ps, unsigned int n, char* status, unsigned short cur_policy, unsigned char cur_time){
+    RealTimeQueue q = rq;
+    // I has 6 bits, so start times range in [0-63].
+    unsigned int count[64] = {0};
+    unsigned int i;
+    char preempt = 0;
+
+    for (i = 0; i < n; i++)
+        if (!PMR(ps[i]) && !placeable(ps[i])) count[STIME(ps[i])]++;
+    for (i = 1; i < 64; i++) count[i] += count[i - 1];
+
+    // sorted holds the indexes of the processes, and accepted the processes which fit.
+    unsigned int* sorted = (unsigned int*) malloc(n * sizeof(unsigned int));
+    Process* accepted = (Process*) malloc(n * sizeof(Process));
+    if (n && (!sorted || !accepted)) handle("no memory to add %d REAL-TIME processes to the process table\n", n);
+    for (i = n; i-- > 0;)
+        if (!PMR(ps[i]) && !placeable(ps[i])) sorted[--count[STIME(ps[i])]] = i;
+
+    // the sweep.
+    unsigned int k = 0;
+    uint64_t busy = q->real_time->busy;
+    for (i = 0; i < count[63]; i++){
+        Process p = ps[sorted[i]];
+        char* s = path(p);
+        Dependency node = find_dependency(q, s, strlen(s));
+        status[sorted[i]] = -1;
+        if (node && node->p)
+            fprintf(stderr, "Process already exists at %s\n", s);
+        else if (ETIME(p) > 60)
+            fprintf(stderr, "Process to be added at %s would run past the end of the minute.\n", s);
+        else if (busy & INTERVAL(STIME(p), ETIME(p)))
+            fprintf(stderr, "Process to be added at %s conflicts with another REAL-TIME process.\n", s);
+        else {
+            busy |= INTERVAL(STIME(p), ETIME(p));
+            // registering the process now also catches two processes at the same path in the batch.
+            node = get_dependency(q, s, strlen(s));
+            node->p = p;
+            node->scheduled = 1;
+            accepted[k++] = p;
+            status[sorted[i]] = preempts(p, cur_policy, cur_time);
+            preempt |= status[sorted[i]];
+            continue;
+        }
+        fprintf(stderr, "The added process will not be executed.\n");
+    }
+    mergeHeap(q->real_time, accepted, k);
+
+    // processes which were waiting for the added ones may now be resolved.
+    for (i = 0; i < k; i++){
+        char* s = path(accepted[i]);
+        reschedule(q, find_dependency(q, s, strlen(s)));
+    }
+
+    for (i = 0; i < n; i++){
+        if (!PMR(ps[i]) && !placeable(ps[i])) continue;
+        status[i] = enqueue(table, rq, ps[i], cur_policy, cur_time, 0);
+        if (status[i] > 0) preempt = 1;
+    }
+
+    free(sorted);
+    free(accepted);
+    return preempt;
+}
+
+// The process is taken out of the heap and put back at its new slot, and the processes
+// which make reference to it are resolved again. If the new slot conflicts with other processes
+// the process goes back to its old slot.
+static char change(ProcessTable table, void* rq, Process p, unsigned short new_policy, unsigned short cur_policy, unsigned char cur_time){
+    RealTimeQueue q = rq;
+    char* s = path(p);
+    Dependency node = find_dependency(q, s, strlen(s));
+    if (!node || node->p != p) return -1;
+
+    unsigned short old_policy = policy(p);
+    char ran = 0;
+    if (node->scheduled){
+        unschedule(q, node);
+        ran = node->ran;
+    }
+    set_policy(p, new_policy);
+    char scheduled = schedule(q, p);
+    char result = 0;
+    if (scheduled < 0){
+        set_policy(p, old_policy);
+        scheduled = schedule(q, p);
+        result = -1;
+    }
+    node->scheduled = scheduled > 0;
+    if (node->scheduled) q->real_time->ran[searchProcess(q->real_time, p)] = ran;
+    reschedule(q, node);
+    if (result < 0 || !node->scheduled) return result;
+    return preempts(p, cur_policy, cur_time);
+}
+
+// REAL-TIME processes are never removed from the run queue when picked.
+static Process pick_next(ProcessTable table, void* rq, unsigned char cur_time){
+    ProcessHeap h = ((RealTimeQueue) rq)->real_time;
+
+    // figure out the position close to which the REAL-TIME process to run would be.
+    int pos = bin_search(h, cur_time);
+    
+    // In case pos returns negative, there are no REAL-TIME processes to run.
+    if (pos < 0) return NULL;
+
+    // If the position is out of bounds, 
+    // then only the last process may possibly be allowed to run.
+    // So we handle that case.
+    if(pos >= h->size){
+        Process cur = h->node[h->size - 1];
+        char cur_ran = h->ran[h->size - 1];
+        if (cur_time < ETIME(cur) && !cur_ran) return cur;
+        return NULL;
+    }
+
+    // get previous and current process
+    Process prev = pos > 0 ? h->node[pos - 1] : NULL;
+    char prev_ran = pos > 0 ? h->ran[pos - 1] : 0;
+    Process cur = h->node[pos];
+    char cur_ran = h->ran[pos];
+
+    // Now we know that start time of prev < cur_time 
+
+    // So we check first if the end time of prev is already up, 
+    // if it isn't, and the process has not yet run its course,
+    // we should simply return prev to run
+    if (prev && !prev_ran && ETIME(prev) > cur_time)
+        return prev;
+
+    // To see if it is cur that has to run, suffices to check
+    // whether cur_time is in betwen the start time of cur
+    // inclusive, and the end time of cur, exclusive.
+    // If cur_time is less than the start time 
+    // there will be a least 1 second of difference between them,
+    // and the scheduler can run a lot of processes in one second.
+    // However, if the ran flag is set for cur, we should really be executing
+    // the next process if one is avaiable.
+    if (STIME(cur) <= cur_time && cur_time < ETIME(cur)){
+        if (!cur_ran) return cur;
+        return pick_next(table, rq, ETIME(cur));
+    }
+
+    // However, we should also check the case cur MAKES_REFERENCE to prev, in which case,
+    // if prev has already run, we should allow cur to run immediately, unless cur_ran is set.
+    if (PMR(cur) && prev_ran){
+        if (!cur_ran) return cur;
+        if (cur_time < ETIME(cur)) return pick_next(table, rq, ETIME(cur));
+    }
+
+    // If the process to run is neither prev nor cur, it must have some other execution policy.
+    return NULL;
+}
+
+static unsigned int slice_for(ProcessTable table, void* rq, Process p, unsigned char cur_time){
+    return DTIME(p) * 1000;
+}
+
+// Time run by REAL-TIME processes is tracked by the ran flags instead, see setRan.
+static void tick(ProcessTable table, void* rq, Process p, unsigned int time_ran){ }
+
+static void reset_period(void* rq){
+    ProcessHeap h = ((RealTimeQueue) rq)->real_time;
+    // Mark all REAL-TIME processes as not run.
+    for (uint16_t i = 0; i < MAX_RTIME; i++)
+        h->ran[i] = 0;
+    // Slack is only good for the minute it was left in.
+    ((RealTimeQueue) rq)->slack = 0;
+}
+
+static void dump(void* rq){
+    ProcessHeap h = ((RealTimeQueue) rq)->real_time;
+    if (!h->size){
+        printf("\tNo REAL-TIME processes.\n\n");
+        return;
+    }
+
+    puts("\tREAL-TIME PROCESSES:");
+    printf("\tTotal time allocated: %d.\n", h->time_used);
+    printf("\tSlack reclaimed this minute: %u milliseconds.\n", ((RealTimeQueue) rq)->slack);
+    printf("\tSlack reclaimed in total: %llu milliseconds.\n", ((RealTimeQueue) rq)->total_slack);
+    printf("\n");
+
+    for (int i = 0; i < h->size; i++){
+        print_process(h->node[i]);
+
+        if (h->ran[i])
+            printf("\t\tand has already run this minute.\n");
+        else
+            printf("\t\tand has not yet run this minute.\n");
+
+        printf("\n");
+    }
+}
+
+const struct sched_class real_time_sched = {
+    .name = "REAL-TIME",
+    .create = create,
+    .destroy = destroy,
+    .enqueue = enqueue,
+    .enqueue_many = enqueue_many,
+    .dequeue = dequeue,
+    .change = change,
+    .pick_next = pick_next,
+    .slice_for = slice_for,
+    .tick = tick,
+    .reset_period = reset_period,
+    .dump = dump,
+};
+
+// total time in seconds reserved each minute by REAL-TIME processes.
+unsigned char real_time_reserved(void* rq){
+    return ((RealTimeQueue) rq)->real_time->time_used;
+}
+
+// milliseconds of REAL-TIME reservations left unused this minute.
+unsigned int real_time_slack(void* rq){
+    return ((RealTimeQueue) rq)->slack;
+}
+
+// marks a REAL-TIME process as having run this minute for time_ran milliseconds.
+// If the process is not in the table, undefined behaviour occurs.
+void releaseRealTime(ProcessTable table, Process p, unsigned int time_ran){
+    RealTimeQueue q = class_queue(table, CLASS_REAL_TIME);
+    ProcessHeap h = q->real_time;
+    int pos = searchProcess(h, p);
+    if (h->ran[pos]) return;
+    h->ran[pos] = 1;
+
+    unsigned int reserved = DTIME(p) * 1000;
+    if (time_ran >= reserved) return;
+
+    // If the next process makes reference to p it starts right away,
+    // so the rest of the window is not slack but the beggining of the next window.
+    if (pos + 1 < h->size && PMR(h->node[pos + 1]) && STIME(h->node[pos + 1]) == ETIME(p))
+        return;
+
+    q->slack += reserved - time_ran;
+    q->total_slack += reserved - time_ran;
+}
+
+// Gets how many milliseconds of their reservations REAL-TIME processes left unused this minute.
+unsigned int getSlack(ProcessTable table){
+    return real_time_slack(class_queue(table, CLASS_REAL_TIME));
+}
+
+// Gets how many milliseconds of slack were reclaimed since the table was created.
+unsigned long long getTotalSlack(ProcessTable table){
+    return ((RealTimeQueue) class_queue(table, CLASS_REAL_TIME))->total_slack;
+}
+
+// Finds the earliest start time at which a REAL-TIME process of the given duration would fit
+// in [earliest, latest], or -1 if there is no free interval large enough.
+char first_free_slot(ProcessTable table, unsigned char duration, unsigned char earliest, unsigned char latest){
+    return first_fit(((RealTimeQueue) class_queue(table, CLASS_REAL_TIME))->real_time, duration, earliest, latest);
+}
+
+// marks a REAL-TIME process as having already run this minute.
+// If the process is not in the table, undefined behaviour occurs.
+void setRan (ProcessTable table, Process p){
+    ProcessHeap h = ((RealTimeQueue) class_queue(table, CLASS_REAL_TIME))->real_time;
+    h->ran[searchProcess(h, p)] = 1;
+}
+
+// checks whether a REAL-TIME process has already run this minute.
+// If the process is not in the table, undefined behaviour occurs.
+char getRan (ProcessTable table, Process p){
+    ProcessHeap h = ((RealTimeQueue) class_queue(table, CLASS_REAL_TIME))->real_time;
+    return h->ran[searchProcess(h, p)];
+}
+
+// gets time in seconds until the next REAL-TIME process is supposed to run.
+// return -1 if there is no next process.
+char time_to_next_real_time(ProcessTable table, unsigned char cur_time){
+    assert(table);
+    ProcessHeap h = ((RealTimeQueue) class_queue(table, CLASS_REAL_TIME))->real_time;
+
+    // figure out the position close to which the REAL-TIME process to run would be.
+    int pos = bin_search(h, cur_time);
+    
+    // In case pos returns negative, there are no REAL-TIME processes to run.
+    if (pos < 0) return -1;
+
+    // If the position is out of bounds,
+    // there is no next process
+    if (pos >= h->size) return -1;
+
+    Process cur = h->node[pos];
+    char cur_ran = h->ran[pos];
+
+    // get supposed time
+    char time = STIME(cur) - cur_time;
+
+    if (time > 0) {
+        if (!cur_ran) return time;
+        else return time + DTIME(cur) + time_to_next_real_time(table, ETIME(cur));
+    }
+    
+    // if time is 0, this means the current process to run is cur,
+    // so what we want is actually the process after that.
+    if (time == 0) 
+        return DTIME(cur) + time_to_next_real_time(table, ETIME(cur));
+
+    return -1;
+}
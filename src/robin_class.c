@@ -0,0 +1,112 @@
+// ROUND-ROBIN scheduling class.
+// Processes take turns running for a fixed time quantum.
+#include <stdlib.h>
+#include <stdio.h>
+#include "sched_class.h"
+#include "process_queue.h"
+
+// The run queue of the class.
+struct robin_queue{
+    // queue of round robin based processes.
+    ProcessQueue robin; 
+    // time in milliseconds ranging in [0-4095] that each round robin process should be allowed to run.
+    unsigned short quantum;
+};
+
+typedef struct robin_queue* RobinQueue;
+
+static void* create(){
+    RobinQueue new = (RobinQueue) malloc(sizeof(struct robin_queue));
+    if (!new) handle("no memory to create area for storing ROUND-ROBIN processes\n");
+    new->robin = createQueue();
+    new->quantum = QUANTUM;
+    return new;
+}
+
+static void destroy(void* rq){
+    RobinQueue q = rq;
+    freeQueue(q->robin);
+    free(q);
+}
+
+static char enqueue(ProcessTable table, void* rq, Process p, unsigned short cur_policy, unsigned char cur_time, unsigned int time_run_last){
+    RobinQueue q = rq;
+    *job_node(table, p) = insertQueue(q->robin, p, 0); // add process to queue
+    //check if quantum should be updated.
+    unsigned short quantum = GET_QUANTUM(policy(p));
+    if(quantum) q->quantum = quantum;
+    // no preemption should occur in favour of a ROUND-ROBIN process.
+    return 0;
+}
+
+// the job of the process keeps its node in the queue.
+static char dequeue(ProcessTable table, void* rq, Process p){
+    void** node = job_node(table, p);
+    if (!*node) return 0;
+    removeNode(((RobinQueue) rq)->robin, *node);
+    *node = NULL;
+    return 1;
+}
+
+// The process keeps its place in the queue, only the quantum may be updated.
+static char change(ProcessTable table, void* rq, Process p, unsigned short new_policy, unsigned short cur_policy, unsigned char cur_time){
+    set_policy(p, new_policy);
+    unsigned short quantum = GET_QUANTUM(new_policy);
+    if(quantum) ((RobinQueue) rq)->quantum = quantum;
+    return 0;
+}
+
+// If there are processes, it is just a matter of popping one from the queue
+static Process pick_next(ProcessTable table, void* rq, unsigned char cur_time){
+    Process p = popQueue(((RobinQueue) rq)->robin);
+    if (p) *job_node(table, p) = NULL;
+    return p;
+}
+
+static unsigned int slice_for(ProcessTable table, void* rq, Process p, unsigned char cur_time){
+    return ((RobinQueue) rq)->quantum;
+}
+
+static void tick(ProcessTable table, void* rq, Process p, unsigned int time_ran){
+    ((RobinQueue) rq)->robin->time_run += time_ran;
+}
+
+static void reset_period(void* rq){
+    // Reset time run for ROUND-ROBIN processes.
+    ((RobinQueue) rq)->robin->time_run = 0;
+}
+
+static void dump(void* rq){
+    RobinQueue q = rq;
+    if (queueEmpty(q->robin)){
+        printf("\tNo ROUND-ROBIN processes.\n");
+        return;
+    }
+
+    puts("\tROUND-ROBIN PROCESSES:");
+    printf("\tTotal time used: %d milliseconds.\n", q->robin->time_run);
+
+    for (Node process = q->robin->head; process; process = process->next){
+        printf("\n");
+        print_process(process->p);
+    }
+}
+
+const struct sched_class robin_sched = {
+    .name = "ROUND-ROBIN",
+    .create = create,
+    .destroy = destroy,
+    .enqueue = enqueue,
+    .dequeue = dequeue,
+    .change = change,
+    .pick_next = pick_next,
+    .slice_for = slice_for,
+    .tick = tick,
+    .reset_period = reset_period,
+    .dump = dump,
+};
+
+// current quantum of the ROUND-ROBIN class.
+unsigned short robin_quantum(void* rq){
+    return ((RobinQueue) rq)->quantum;
+}
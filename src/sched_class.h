@@ -0,0 +1,94 @@
+// Interface for scheduling classes, internal to the ProcessTable.
+// Each execution policy (REAL-TIME, PRIORITY, ROUND-ROBIN) is implemented by a class,
+// which keeps its processes in a run queue of its own and is only reached through the
+// function pointers below. The process table just dispatches to the classes, so a new
+// policy can be added by writing a new class, without touching next_process or insertProcess.
+#pragma once
+#include "process_table.h"
+
+// Slots of the classes in the process table.
+// The REAL-TIME class always has precedence, the other classes take turns.
+#define CLASS_REAL_TIME 0
+#define CLASS_PRIORITY 1
+#define CLASS_ROUND_ROBIN 2
+#define NR_CLASSES 3
+
+// first class which takes turns with the others.
+#define FIRST_BEST_EFFORT CLASS_PRIORITY
+
+struct sched_class{
+    // name of the class, as printed by table_show.
+    const char* name;
+
+    // creates an empty run queue for the class.
+    void* (*create)(void);
+
+    // frees the run queue, along with the processes in it.
+    void (*destroy)(void* rq);
+
+    // puts p in the run queue.
+    // Returns 1 if p should preempt the current process, -1 if it can't be added, otherwise 0.
+    // The arguments after p are the same as the ones of insertProcess.
+    char (*enqueue)(ProcessTable table, void* rq, Process p, unsigned short cur_policy, unsigned char cur_time, unsigned int time_run_last);
+
+    // puts n processes of the class in the run queue at once, giving the result of each one in status,
+    // as enqueue would. Returns 1 if any of them should preempt the current process, otherwise 0.
+    // Classes which have nothing to gain from it may leave it NULL, and enqueue is called for each process instead.
+    char (*enqueue_many)(ProcessTable table, void* rq, Process* ps, unsigned int n, char* status, unsigned short cur_policy, unsigned char cur_time);
+
+    // takes p out of the run queue without freeing it.
+    // Returns 0 if p was not in the run queue, e.g. because it was picked and is running.
+    char (*dequeue)(ProcessTable table, void* rq, Process p);
+
+    // changes the policy of p, which is in the run queue or was picked from it, to new_policy of the same class,
+    // moving p within the run queue and keeping what the class accounted for it.
+    // Returns 1 if p should now preempt the current process, -1 if the policy can't be changed, otherwise 0.
+    // cur_policy and cur_time are the same as the ones of insertProcess.
+    char (*change)(ProcessTable table, void* rq, Process p, unsigned short new_policy, unsigned short cur_policy, unsigned char cur_time);
+
+    // chooses the process of the class that should run at cur_time, or NULL if there is none.
+    // Classes other than REAL-TIME remove the chosen process from the run queue.
+    Process (*pick_next)(ProcessTable table, void* rq, unsigned char cur_time);
+
+    // time in milliseconds that p, picked at cur_time, should be allowed to run.
+    unsigned int (*slice_for)(ProcessTable table, void* rq, Process p, unsigned char cur_time);
+
+    // accounts for p having run for time_ran milliseconds.
+    // This is called right before p is put back in the run queue.
+    void (*tick)(ProcessTable table, void* rq, Process p, unsigned int time_ran);
+
+    // resets the information of the run queue for the next minute.
+    void (*reset_period)(void* rq);
+
+    // prints the run queue to stdout.
+    void (*dump)(void* rq);
+};
+
+typedef const struct sched_class* SchedClass;
+
+// the classes.
+extern const struct sched_class real_time_sched;
+extern const struct sched_class priority_sched;
+extern const struct sched_class fair_sched;
+extern const struct sched_class robin_sched;
+
+// Gets the run queue of a class slot in the table.
+void* class_queue(ProcessTable table, unsigned char cls);
+
+// Gets the slot of the job of p where its class may keep the node of p in the run queue,
+// so that dequeue doesn't have to search for it. The slot is NULL when p is added to the table.
+void** job_node(ProcessTable table, Process p);
+
+// Utilities classes provide to each other.
+
+// total time in seconds reserved each minute by REAL-TIME processes.
+unsigned char real_time_reserved(void* rq);
+
+// milliseconds of REAL-TIME reservations left unused this minute, see releaseRealTime.
+unsigned int real_time_slack(void* rq);
+
+// time slice in milliseconds of the fair class, see getFairSlice.
+unsigned short fair_slice(void* rq);
+
+// current quantum of the ROUND-ROBIN class, see getQuantum.
+unsigned short robin_quantum(void* rq);
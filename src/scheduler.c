@@ -59,7 +59,7 @@ static unsigned char get_rel_time(){
 static unsigned int get_time_ran(){
     // get current time
     gettimeofday(&cur_time, NULL);
-    return (__useconds_t) (cur_time.tv_usec - start_time.tv_usec) / 1000;
+    return (cur_time.tv_sec - start_time.tv_sec) * 1000 + (cur_time.tv_usec - start_time.tv_usec) / 1000;
 }
 
 static void disarm_timer(){
@@ -81,7 +81,8 @@ static void disable_current_process(){
         if (!POLICY_REAL_TIME(pol))
             // no preemption should be possible to occur.
             insertProcess(table, p, pol, 0, time_ran);
-        else setRan(table, p);
+        // what it didn't use of its reservation is handed to the other processes.
+        else releaseRealTime(table, p, time_ran);
         // stop the process.
         kill(pid, SIGSTOP);
     }
@@ -105,9 +106,10 @@ static void check_minute(){
 int context_switches;
 #endif // TEST
 
-int main(void){
+int main(int argc, char const *argv[]){
     // set values for static variables.
-    table = create_table();
+    // the fair implementation of the PRIORITY class is chosen with the --fair argument.
+    table = create_table_with_class(argc > 1 && !strcmp(argv[1], "--fair") ? FAIR_PRIORITY : STRICT_PRIORITY);
     p = NULL;
     
     // reference shared memory area with key 0x2230
@@ -234,7 +236,6 @@ static void context_switch(int signal){
     unsigned char relative_time = get_rel_time();
     pid_t pid;
     int time_to_next_alarm;
-    unsigned short pol;
     // if there is a current process we need to
     // make it inactive.
     disable_current_process();
@@ -267,19 +268,7 @@ static void context_switch(int signal){
     gettimeofday(&start_time, NULL);
 
     // figure out when to context switch next.
-    pol = policy(p);
-    switch (PLP(pol)){
-    case REAL_TIME:
-        time_to_next_alarm = GET_D(pol) * 1000;
-        break;
-    case ROUND_ROBIN:
-        time_to_next_alarm = getQuantum(table);
-        break;
-    case PRIORITY:
-        time_to_next_alarm = time_to_next_real_time(table, relative_time) * 1000;
-        if (time_to_next_alarm < 0) time_to_next_alarm = 10000;
-        break;
-    }
+    time_to_next_alarm = time_slice(table, p, relative_time);
 
     // it shouldnt be possible for time_to_next_alarm to be negative here.
     assert(time_to_next_alarm > 0);
@@ -296,20 +285,23 @@ static void context_switch(int signal){
     
 }
 
+// Several children may end for a single signal, and not necessarily the current process,
+// so every child that ended is reaped and found by its PID.
 static void process_ended(int signal){
-    if (!p) return;
-    char* str = path(p);
-    pid_t pid = get_pid(p);
+    pid_t pid;
     int status;
-    
-    
-    waitpid(pid, &status, 0);
-    if (WIFEXITED(status)) {
-        pid = fork_util(str);
-        set_pid(p, pid);
 
-        disarm_timer();
-        context_switch(0);
+    while ((pid = waitpid(-1, &status, WNOHANG)) > 0){
+        Process ended = find_pid(table, pid);
+        if (!ended || !WIFEXITED(status)) continue;
+
+        // processes which exit are started over.
+        if (ended == p){
+            table_set_pid(table, p, fork_util(path(p)));
+            disarm_timer();
+            context_switch(0);
+        }
+        else table_set_pid(table, ended, fork_stop(path(ended)));
     }
 }
 
@@ -10,13 +10,13 @@
 #define MAX_PATH 100
 
 // size of process struct
-#define PROCESS_SIZE 208
+#define PROCESS_SIZE 212
 
 typedef struct process* Process;
 
 // Creates a new Process.
-// A process which does not make reference to another is immutable except for PID value,
-// so after creation its path and policy cannot be changed.
+// A process which does not make reference to another is immutable except for PID value and policy,
+// so after creation its path cannot be changed, and its policy can only be changed by set_policy.
 Process create_process(const char* path, unsigned short policy);
 
 // Creates the process with an extra path used for scheduling.
@@ -28,6 +28,13 @@ Process create_process(const char* path, unsigned short policy);
 // See resolve below for details.
 Process create_process_with_relative_schedule(const char* path, char* Ipath, unsigned short policy);
 
+// Creates a REAL-TIME process which only specifies its duration (the D option)
+// and lets the scheduler place it. The scheduler picks the earliest free interval of the minute
+// which starts at or after earliest and ends at or before latest, so [0, 60] means anywhere.
+// The I value of the policy is ignored until the process is placed. See place below.
+// The MAKES_REFERENCE flag must not be set.
+Process create_process_with_window(const char* path, unsigned short policy, unsigned char earliest, unsigned char latest);
+
 // Process policy.
 unsigned short policy(Process p);
 
@@ -68,8 +75,13 @@ unsigned short policy(Process p);
 // to wait out for C to start at its appropriate time. This ensures that a process which makes reference to another
 // starts immediatly after it ends, but if it specifies an execution time explicitly this is respected by the system.
 
-// If the MAKES_REFERENCE flag is set we know that the process that B refers to is always the 
-// last process run before B runs. We assume also that if B makes reference to a process this process
+// An Ipath may also list several paths separated by REFERENCE_SEPARATOR, as in I=A:C,
+// in which case B starts when the last of the processes it makes reference to ends.
+// The processes referred to need not be added to the scheduler before B; B simply waits until
+// all of them are, and its start time is resolved again whenever one of them is added, moved or removed.
+
+// If the MAKES_REFERENCE flag is set we know that the process that B refers to (the last one to end, if there are several)
+// is always the last process run before B runs. We assume also that if B makes reference to a process this process
 // must be a REAL_TIME process as well, since this is the only way we can resolve I to a proper value and avoid
 // conflicts with future REAL_TIME processes.
 
@@ -81,6 +93,9 @@ unsigned short policy(Process p);
 #define PRIORITY 0x04
 #define MAKES_REFERENCE 0x08
 
+// separates the paths of an Ipath which makes reference to several processes.
+#define REFERENCE_SEPARATOR ':'
+
 // returns true or false depending on whether the flag is set.
 #define POLICY_ROUND_ROBIN(x)          ((x) & ROUND_ROBIN)
 #define POLICY_REAL_TIME(x)            ((x) & REAL_TIME)
@@ -180,6 +195,24 @@ char* Ipath(Process p);
 // An error will be generated if the MAKES_REFERENCE flag is off.
 void resolve(Process p, unsigned char start_time);
 
+// Changes the policy of a process, as when it is reniced or given a new REAL-TIME slot.
+// The MAKES_REFERENCE flag cannot be changed, since it goes with the Ipath of the process.
+// A placeable process keeps its window while it stays REAL-TIME, so the new D value must fit the window
+// and the new I value is meaningless until the process is placed again. Otherwise it loses its window.
+// An error will be generated if the policy is invalid or breaks any of these rules.
+void set_policy(Process p, unsigned short policy);
+
+// Whether the process was created with a window and so asked to be placed by the scheduler.
+char placeable(Process p);
+
+// Window of the minute in which a placeable process may run.
+unsigned char window_start(Process p);
+unsigned char window_end(Process p);
+
+// A placeable process can be changed by this routine so as to have its STIME value changed to start_time.
+// An error will be generated if the process is not placeable or if it would not fit its window.
+void place(Process p, unsigned char start_time);
+
 // Free the memory associated with the process.
 void free_process(Process p);
 
@@ -195,6 +228,15 @@ int get_pid(Process p);
 
 int set_pid(Process p, int pid);
 
+// Handle of the job of a process in a process table, see process_table.h.
+// Like the PID it is only used by the scheduler, and it is NO_JOB until the process is added to a table.
+// Copies of a process do not keep its handle.
+typedef unsigned int JobHandle;
+#define NO_JOB 0
+
+JobHandle get_handle(Process p);
+void set_handle(Process p, JobHandle handle);
+
 // Print process to stdout.
 void print_process(Process p);
 
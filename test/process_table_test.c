@@ -3,6 +3,8 @@
 #include "unity/unity.h"
 // use "puts" on occasion for debuging.
 #include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
 
 // @Author: Luiz Carlos Rumbelsperger Viana
 // Using unity test framework, from http://www.throwtheswitch.org/unity
@@ -275,6 +277,465 @@ void test_priority_and_robin(void){
     // TODO
 }
 
+void test_fair_class_shares_time_by_weight(void){
+    ProcessTable table = create_table_with_class(FAIR_PRIORITY);
+
+    // a level 0 process should get twice the time of a level 1 process,
+    // and four times the time of a level 3 process.
+    Process p0 = create_process("/bin/bash", PRIORITY | P0);
+    Process p1 = create_process("/bin/cat", PRIORITY | P1);
+    Process p3 = create_process("/bin/echo", PRIORITY | P3);
+    TEST_ASSERT_FALSE(insertProcess(table, p0, 0, 0, 0));
+    TEST_ASSERT_FALSE(insertProcess(table, p1, 0, 0, 0));
+    TEST_ASSERT_FALSE(insertProcess(table, p3, 0, 0, 0));
+
+    // the slice is shared between the 3 queued processes.
+    TEST_ASSERT_EQUAL_UINT16(FAIR_LATENCY / 3, getFairSlice(table));
+
+    // processes with the same virtual runtime run in arrival order.
+    Process next = next_process(table, 0);
+    TEST_ASSERT_EQUAL_PTR(p0, next);
+    TEST_ASSERT_FALSE(insertProcess(table, next, policy(next), 0, 0));
+
+    unsigned int ran0 = 0, ran1 = 0, ran3 = 0;
+    for (int i = 0; i < 700; i++){
+        next = next_process(table, 0);
+        if (next == p0) ran0 += 100;
+        else if (next == p1) ran1 += 100;
+        else if (next == p3) ran3 += 100;
+        else TEST_FAIL_MESSAGE("unknown process was chosen to run");
+        TEST_ASSERT_FALSE(insertProcess(table, next, policy(next), 0, 100));
+    }
+
+    // weights are 4 : 2 : 1, so out of 70 seconds the shares are 40, 20 and 10 seconds,
+    // give or take a slice.
+    TEST_ASSERT_UINT_WITHIN(100, 40000, ran0);
+    TEST_ASSERT_UINT_WITHIN(100, 20000, ran1);
+    TEST_ASSERT_UINT_WITHIN(100, 10000, ran3);
+
+    // newly added fair processes never preempt, not even a process of a higher level.
+    Process late = create_process("/bin/late", PRIORITY | P0);
+    TEST_ASSERT_FALSE(insertProcess(table, late, PRIORITY | P7, 0, 0));
+
+    // strict tables do not hand out fair slices.
+    ProcessTable strict = create_table();
+    TEST_ASSERT_EQUAL_UINT16(0, getFairSlice(strict));
+    free_table(strict);
+
+    // table_show(table);
+    free_table(table);
+}
+
+// Measures fairness error and pick-next cost of the fair class with 100k queued processes.
+void test_fair_class_with_100k_processes(void){
+    const int jobs = 100000;
+    const int picks = 1000000;
+    const unsigned int slice = 10;
+    ProcessTable table = create_table_with_class(FAIR_PRIORITY);
+    unsigned int* ran = calloc(jobs, sizeof(unsigned int));
+    char buffer[MAX_PATH];
+    double weights = 0;
+    int i;
+
+    // processes are spread evenly over the 8 levels.
+    // paths encode the index of the process so that we can account for it.
+    for (i = 0; i < jobs; i++){
+        sprintf(buffer, "job/%d", i);
+        insertProcess(table, create_process(buffer, PRIORITY | ((i % PRIOR_LEVELS) << 4)), 0, 0, 0);
+        weights += 1.0 / (i % PRIOR_LEVELS + 1);
+    }
+
+    struct timespec start, end;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (i = 0; i < picks; i++){
+        Process next = next_process(table, 0);
+        ran[atoi(path(next) + 4)] += slice;
+        insertProcess(table, next, policy(next), 0, slice);
+    }
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    double ns = (end.tv_sec - start.tv_sec) * 1e9 + (end.tv_nsec - start.tv_nsec);
+
+    // fairness error is how far the time each process received is from its weighted share.
+    double total = (double) picks * slice;
+    double error = 0;
+    for (i = 0; i < jobs; i++){
+        double share = total * (1.0 / (i % PRIOR_LEVELS + 1)) / weights;
+        double diff = ran[i] > share ? ran[i] - share : share - ran[i];
+        if (diff > error) error = diff;
+    }
+    printf("fair class with %d processes: %.1f ns per pick and requeue, max fairness error %.1f ms\n",
+           jobs, ns / picks, error);
+
+    // vruntimes never drift apart by more than one slice of the lowest level.
+    TEST_ASSERT_TRUE(error <= slice * PRIOR_LEVELS);
+
+    free(ran);
+    free_table(table);
+}
+
+void test_classes_take_turns_and_give_slices(void){
+    ProcessTable table = create_table();
+
+    Process prio = create_process("/bin/bash", PRIORITY | P1);
+    Process robin = create_process("/bin/cat", ROUND_ROBIN | SET_ROBIN_TIME(300));
+    Process real = create_process("/bin/echo", REAL_TIME | SET_I(30) | SET_D(10));
+    TEST_ASSERT_FALSE(insertProcess(table, prio, 0, 0, 0));
+    TEST_ASSERT_FALSE(insertProcess(table, robin, 0, 0, 0));
+    TEST_ASSERT_FALSE(insertProcess(table, real, 0, 0, 0));
+
+    // PRIORITY and ROUND-ROBIN processes take turns until the REAL-TIME process has to run.
+    for (int i = 0; i < 10; i++){
+        Process next = next_process(table, 20);
+        TEST_ASSERT_EQUAL_PTR(i % 2 ? robin : prio, next);
+        TEST_ASSERT_FALSE(insertProcess(table, next, policy(next), 20, 100));
+    }
+    TEST_ASSERT_EQUAL_PTR(real, next_process(table, 30));
+
+    // each class decides how long its processes may run.
+    TEST_ASSERT_EQUAL_UINT(10 * 1000, time_slice(table, prio, 20));
+    TEST_ASSERT_EQUAL_UINT(300, time_slice(table, robin, 20));
+    TEST_ASSERT_EQUAL_UINT(10 * 1000, time_slice(table, real, 30));
+
+    // table_show(table);
+    free_table(table);
+}
+
+void test_slack_of_real_time_processes_is_reclaimed(void){
+    ProcessTable table = create_table();
+
+    // REAL-TIME processes reserve 50 seconds of every minute.
+    Process real = create_process("/bin/real", REAL_TIME | SET_I(0) | SET_D(40));
+    Process chained = create_process("/bin/chained", REAL_TIME | SET_I(45) | SET_D(5));
+    Process ref = create_process_with_relative_schedule("/bin/ref", "/bin/chained", REAL_TIME | SET_D(5));
+    TEST_ASSERT_FALSE(insertProcess(table, real, 0, 0, 0));
+    TEST_ASSERT_FALSE(insertProcess(table, chained, 0, 0, 0));
+    TEST_ASSERT_FALSE(insertProcess(table, ref, 0, 0, 0));
+
+    // so a single priority level may run for 0.8 * 10 seconds.
+    // Having run for 9 seconds it is blocked for the rest of the minute.
+    Process prio = create_process("/bin/prio", PRIORITY | P0);
+    TEST_ASSERT_FALSE(insertProcess(table, prio, 0, 0, 9000));
+    TEST_ASSERT_NULL(next_process(table, 40));
+
+    // The REAL-TIME process exits after 2 seconds, leaving 38 seconds of slack,
+    // so the level gets a share of those and can run again.
+    reset(table);
+    TEST_ASSERT_EQUAL_PTR(real, next_process(table, 0));
+    releaseRealTime(table, real, 2000);
+    TEST_ASSERT_TRUE(getRan(table, real));
+    TEST_ASSERT_EQUAL_UINT(38000, getSlack(table));
+    TEST_ASSERT_EQUAL_PTR(prio, next_process(table, 2));
+    TEST_ASSERT_FALSE(insertProcess(table, prio, policy(prio), 2, 9000));
+    TEST_ASSERT_EQUAL_PTR(prio, next_process(table, 2));
+    TEST_ASSERT_FALSE(insertProcess(table, prio, policy(prio), 2, 1));
+
+    // A process which ends early does not leave slack when the next process makes
+    // reference to it, since that process starts right away.
+    releaseRealTime(table, chained, 1000);
+    TEST_ASSERT_EQUAL_UINT(38000, getSlack(table));
+    TEST_ASSERT_EQUAL_PTR(ref, next_process(table, 46));
+
+    // slack is counted per minute, but also in total.
+    releaseRealTime(table, ref, 5000);
+    reset(table);
+    TEST_ASSERT_EQUAL_UINT(0, getSlack(table));
+    TEST_ASSERT_EQUAL_UINT64(38000, getTotalSlack(table));
+
+    // table_show(table);
+    free_table(table);
+}
+
+void test_real_time_processes_are_placed_first_fit(void){
+    ProcessTable table = create_table();
+
+    // reserve [10, 20) and [25, 30).
+    Process a = create_process("/bin/a", REAL_TIME | SET_I(10) | SET_D(10));
+    Process b = create_process("/bin/b", REAL_TIME | SET_I(25) | SET_D(5));
+    TEST_ASSERT_FALSE(insertProcess(table, a, 0, 0, 0));
+    TEST_ASSERT_FALSE(insertProcess(table, b, 0, 0, 0));
+
+    // the earliest gap that fits 5 seconds after second 8 is [20, 25).
+    TEST_ASSERT_EQUAL_INT8(0, first_free_slot(table, 5, 0, 60));
+    TEST_ASSERT_EQUAL_INT8(20, first_free_slot(table, 5, 8, 60));
+    TEST_ASSERT_EQUAL_INT8(30, first_free_slot(table, 6, 8, 60));
+    TEST_ASSERT_EQUAL_INT8(-1, first_free_slot(table, 6, 8, 35));
+    TEST_ASSERT_EQUAL_INT8(-1, first_free_slot(table, 31, 0, 60));
+
+    Process placed = create_process_with_window("/bin/placed", REAL_TIME | SET_D(5), 8, 60);
+    TEST_ASSERT_TRUE(placeable(placed));
+    TEST_ASSERT_FALSE(insertProcess(table, placed, 0, 0, 0));
+    TEST_ASSERT_EQUAL_UINT8(20, STIME(placed));
+    TEST_ASSERT_EQUAL_PTR(placed, next_process(table, 22));
+
+    // a process which fits nowhere in its window is rejected.
+    Process tight = create_process_with_window("/bin/tight", REAL_TIME | SET_D(3), 10, 30);
+    TEST_ASSERT_EQUAL_INT8(-1, insertProcess(table, tight, 0, 0, 0));
+    free_process(tight);
+
+    // the whole minute is the default window of the interpreter.
+    Process anywhere = create_process_with_window("/bin/anywhere", REAL_TIME | SET_D(10), 0, 60);
+    TEST_ASSERT_FALSE(insertProcess(table, anywhere, 0, 0, 0));
+    TEST_ASSERT_EQUAL_UINT8(0, STIME(anywhere));
+
+    // explicit start times are checked against every reserved second.
+    Process overlap = create_process("/bin/overlap", REAL_TIME | SET_I(9) | SET_D(3));
+    TEST_ASSERT_EQUAL_INT8(-1, insertProcess(table, overlap, 0, 0, 0));
+    free_process(overlap);
+
+    // table_show(table);
+    free_table(table);
+}
+
+void test_real_time_processes_wait_for_everything_they_make_reference_to(void){
+    ProcessTable table = create_table();
+
+    // c runs after both a and b, and d runs after c, but they are added before any of them.
+    Process c = create_process_with_relative_schedule("/bin/c", "/bin/a:/bin/b", REAL_TIME | SET_D(5));
+    Process d = create_process_with_relative_schedule("/bin/d", "/bin/c", REAL_TIME | SET_D(2));
+    TEST_ASSERT_FALSE(insertProcess(table, c, 0, 0, 0));
+    TEST_ASSERT_FALSE(insertProcess(table, d, 0, 0, 0));
+
+    Process a = create_process("/bin/a", REAL_TIME | SET_I(10) | SET_D(10));
+    TEST_ASSERT_FALSE(insertProcess(table, a, 0, 0, 0));
+    // c still waits for b, and so does d.
+    TEST_ASSERT_EQUAL_PTR(a, next_process(table, 10));
+    setRan(table, a);
+    TEST_ASSERT_NULL(next_process(table, 20));
+
+    // once b is added the whole chain is resolved.
+    Process b = create_process("/bin/b", REAL_TIME | SET_I(25) | SET_D(5));
+    TEST_ASSERT_FALSE(insertProcess(table, b, 0, 0, 0));
+    TEST_ASSERT_EQUAL_UINT8(30, STIME(c));
+    TEST_ASSERT_EQUAL_UINT8(35, STIME(d));
+    TEST_ASSERT_TRUE(getRan(table, a));
+    TEST_ASSERT_EQUAL_PTR(b, next_process(table, 25));
+    setRan(table, b);
+    TEST_ASSERT_EQUAL_PTR(c, next_process(table, 30));
+    setRan(table, c);
+    TEST_ASSERT_EQUAL_PTR(d, next_process(table, 35));
+
+    // a reference which would run past the end of the minute is rejected.
+    Process late = create_process("/bin/late", REAL_TIME | SET_I(50) | SET_D(8));
+    Process after = create_process_with_relative_schedule("/bin/after", "/bin/late:/bin/c", REAL_TIME | SET_D(5));
+    TEST_ASSERT_FALSE(insertProcess(table, late, 0, 0, 0));
+    TEST_ASSERT_EQUAL_INT8(-1, insertProcess(table, after, 0, 0, 0));
+    free_process(after);
+
+    // table_show(table);
+    free_table(table);
+}
+
+void test_jobs_are_removed_by_handle(void){
+    ProcessTable table = create_table();
+
+    // ROUND-ROBIN and PRIORITY based processes are taken out of the middle of their queues.
+    Process a = create_process("/bin/a", ROUND_ROBIN);
+    Process b = create_process("/bin/b", ROUND_ROBIN);
+    Process c = create_process("/bin/c", ROUND_ROBIN);
+    Process prio = create_process("/bin/prio", PRIORITY | P1);
+    TEST_ASSERT_EQUAL_UINT(NO_JOB, get_handle(a));
+    TEST_ASSERT_FALSE(insertProcess(table, a, 0, 0, 0));
+    TEST_ASSERT_FALSE(insertProcess(table, b, 0, 0, 0));
+    TEST_ASSERT_FALSE(insertProcess(table, c, 0, 0, 0));
+    TEST_ASSERT_FALSE(insertProcess(table, prio, 0, 0, 0));
+    JobHandle job = get_handle(b);
+    TEST_ASSERT_EQUAL_PTR(b, find_job(table, job));
+    TEST_ASSERT_TRUE(cancelProcess(table, job));
+    TEST_ASSERT_TRUE(cancelProcess(table, get_handle(prio)));
+
+    // the handle of a removed job is stale, even once its job is reused.
+    TEST_ASSERT_NULL(find_job(table, job));
+    TEST_ASSERT_FALSE(cancelProcess(table, job));
+    Process d = create_process("/bin/d", ROUND_ROBIN);
+    TEST_ASSERT_FALSE(insertProcess(table, d, 0, 0, 0));
+    TEST_ASSERT_NOT_EQUAL(job, get_handle(d));
+    TEST_ASSERT_NULL(find_job(table, job));
+
+    TEST_ASSERT_EQUAL_PTR(a, next_process(table, 0));
+    TEST_ASSERT_EQUAL_PTR(c, next_process(table, 0));
+
+    // a running process keeps its handle, and can be removed too.
+    job = get_handle(a);
+    TEST_ASSERT_EQUAL_PTR(a, find_job(table, job));
+    TEST_ASSERT_FALSE(insertProcess(table, a, ROUND_ROBIN, 0, 100));
+    TEST_ASSERT_EQUAL_UINT(job, get_handle(a));
+    TEST_ASSERT_EQUAL_PTR(c, removeProcess(table, get_handle(c)));
+    free_process(c);
+    TEST_ASSERT_EQUAL_PTR(d, next_process(table, 0));
+    TEST_ASSERT_EQUAL_PTR(a, next_process(table, 0));
+    TEST_ASSERT_NULL(next_process(table, 0));
+    TEST_ASSERT_TRUE(cancelProcess(table, get_handle(a)));
+    TEST_ASSERT_TRUE(cancelProcess(table, get_handle(d)));
+
+    // processes which make reference to a removed REAL-TIME process wait for a new one.
+    Process rt = create_process("/bin/rt", REAL_TIME | SET_I(10) | SET_D(10));
+    Process ref = create_process_with_relative_schedule("/bin/ref", "/bin/rt", REAL_TIME | SET_D(5));
+    TEST_ASSERT_FALSE(insertProcess(table, rt, 0, 0, 0));
+    TEST_ASSERT_FALSE(insertProcess(table, ref, 0, 0, 0));
+    TEST_ASSERT_TRUE(cancelProcess(table, get_handle(rt)));
+    TEST_ASSERT_NULL(next_process(table, 10));
+    TEST_ASSERT_NULL(next_process(table, 20));
+    rt = create_process("/bin/rt", REAL_TIME | SET_I(30) | SET_D(10));
+    TEST_ASSERT_FALSE(insertProcess(table, rt, 0, 0, 0));
+    TEST_ASSERT_EQUAL_UINT8(40, STIME(ref));
+    TEST_ASSERT_EQUAL_PTR(ref, next_process(table, 40));
+
+    // fair processes are taken out of the tree.
+    ProcessTable fair = create_table_with_class(FAIR_PRIORITY);
+    Process f0 = create_process("/bin/f0", PRIORITY | P0);
+    Process f1 = create_process("/bin/f1", PRIORITY | P0);
+    TEST_ASSERT_FALSE(insertProcess(fair, f0, 0, 0, 0));
+    TEST_ASSERT_FALSE(insertProcess(fair, f1, 0, 0, 0));
+    TEST_ASSERT_TRUE(cancelProcess(fair, get_handle(f0)));
+    TEST_ASSERT_EQUAL_PTR(f1, next_process(fair, 0));
+    TEST_ASSERT_NULL(next_process(fair, 0));
+    TEST_ASSERT_TRUE(cancelProcess(fair, get_handle(f1)));
+    free_table(fair);
+
+    // table_show(table);
+    free_table(table);
+}
+
+void test_policies_are_changed_in_place(void){
+    ProcessTable table = create_table();
+
+    // a ROUND-ROBIN process keeps its place, and may update the quantum.
+    Process a = create_process("/bin/a", ROUND_ROBIN);
+    Process b = create_process("/bin/b", ROUND_ROBIN);
+    TEST_ASSERT_FALSE(insertProcess(table, a, 0, 0, 0));
+    TEST_ASSERT_FALSE(insertProcess(table, b, 0, 0, 0));
+    TEST_ASSERT_FALSE(change_policy(table, get_handle(a), ROUND_ROBIN | SET_ROBIN_TIME(300), 0, 0));
+    TEST_ASSERT_EQUAL_UINT16(300, getQuantum(table));
+
+    // b becomes PRIORITY based, which has precedence, keeping its handle.
+    JobHandle job = get_handle(b);
+    TEST_ASSERT_FALSE(change_policy(table, job, PRIORITY | P2, 0, 0));
+    TEST_ASSERT_EQUAL_UINT(job, get_handle(b));
+    TEST_ASSERT_EQUAL_PTR(b, next_process(table, 0));
+    // while it runs it can be reniced, and it enters its new level when put back.
+    TEST_ASSERT_FALSE(change_policy(table, job, PRIORITY | P4, 0, 0));
+    TEST_ASSERT_FALSE(insertProcess(table, b, policy(b), 0, 100));
+    TEST_ASSERT_EQUAL_PTR(a, next_process(table, 0));
+    TEST_ASSERT_EQUAL_PTR(b, next_process(table, 0));
+    TEST_ASSERT_EQUAL_UINT16(PRIORITY | P4, policy(b));
+
+    // invalid policies and stale handles are refused.
+    TEST_ASSERT_EQUAL_INT8(-1, change_policy(table, job, PRIORITY | ROUND_ROBIN, 0, 0));
+    TEST_ASSERT_EQUAL_INT8(-1, change_policy(table, job, REAL_TIME | MAKES_REFERENCE | SET_D(2), 0, 0));
+    TEST_ASSERT_TRUE(cancelProcess(table, get_handle(a)));
+    TEST_ASSERT_TRUE(cancelProcess(table, job));
+    TEST_ASSERT_EQUAL_INT8(-1, change_policy(table, job, ROUND_ROBIN, 0, 0));
+
+    // a REAL-TIME process is reslotted, and whatever makes reference to it follows.
+    Process rt = create_process("/bin/rt", REAL_TIME | SET_I(10) | SET_D(10));
+    Process other = create_process("/bin/other", REAL_TIME | SET_I(45) | SET_D(5));
+    Process ref = create_process_with_relative_schedule("/bin/ref", "/bin/rt", REAL_TIME | SET_D(5));
+    TEST_ASSERT_FALSE(insertProcess(table, rt, 0, 0, 0));
+    TEST_ASSERT_FALSE(insertProcess(table, other, 0, 0, 0));
+    TEST_ASSERT_FALSE(insertProcess(table, ref, 0, 0, 0));
+    TEST_ASSERT_EQUAL_UINT8(20, STIME(ref));
+    setRan(table, rt);
+    TEST_ASSERT_FALSE(change_policy(table, get_handle(rt), REAL_TIME | SET_I(25) | SET_D(10), 0, 0));
+    TEST_ASSERT_EQUAL_UINT8(35, STIME(ref));
+    TEST_ASSERT_TRUE(getRan(table, rt));
+    TEST_ASSERT_NULL(next_process(table, 20));
+
+    // a slot which conflicts leaves everything as it was.
+    TEST_ASSERT_EQUAL_INT8(-1, change_policy(table, get_handle(rt), REAL_TIME | SET_I(40) | SET_D(10), 0, 0));
+    TEST_ASSERT_EQUAL_UINT8(25, STIME(rt));
+    TEST_ASSERT_EQUAL_UINT8(35, STIME(ref));
+
+    // moving a process right after the current REAL-TIME process preempts it as insertProcess would.
+    TEST_ASSERT_TRUE(change_policy(table, get_handle(other), REAL_TIME | SET_I(40) | SET_D(5), policy(ref), 40));
+
+    // table_show(table);
+    free_table(table);
+}
+
+void test_processes_are_inserted_in_bulk(void){
+    ProcessTable table = create_table();
+    Process old = create_process("/bin/old", REAL_TIME | SET_I(20) | SET_D(5));
+    TEST_ASSERT_FALSE(insertProcess(table, old, 0, 0, 0));
+
+    Process ps[9] = {
+        create_process_with_relative_schedule("/bin/ref", "/bin/late", REAL_TIME | SET_D(5)),
+        create_process("/bin/late", REAL_TIME | SET_I(40) | SET_D(5)),
+        create_process("/bin/robin", ROUND_ROBIN),
+        create_process("/bin/early", REAL_TIME | SET_I(0) | SET_D(10)),
+        create_process("/bin/overlaps_old", REAL_TIME | SET_I(22) | SET_D(5)),
+        create_process("/bin/overlaps_early", REAL_TIME | SET_I(5) | SET_D(2)),
+        create_process("/bin/early", REAL_TIME | SET_I(30) | SET_D(2)),
+        create_process_with_window("/bin/placed", REAL_TIME | SET_D(5), 0, 60),
+        create_process("/bin/prio", PRIORITY | P1),
+    };
+    char status[9];
+    TEST_ASSERT_FALSE(insertProcesses(table, ps, 9, status, 0, 0));
+
+    char expected[9] = {0, 0, 0, 0, -1, -1, -1, 0, 0};
+    TEST_ASSERT_EQUAL_INT8_ARRAY(expected, status, 9);
+    TEST_ASSERT_EQUAL_UINT8(45, STIME(ps[0]));
+    TEST_ASSERT_EQUAL_UINT8(10, STIME(ps[7]));
+    for (int i = 4; i < 7; i++){
+        TEST_ASSERT_EQUAL_UINT(NO_JOB, get_handle(ps[i]));
+        free_process(ps[i]);
+    }
+
+    // REAL-TIME processes run in order of start time, the others between them.
+    TEST_ASSERT_EQUAL_PTR(ps[3], next_process(table, 0));
+    TEST_ASSERT_EQUAL_PTR(ps[7], next_process(table, 10));
+    TEST_ASSERT_EQUAL_PTR(old, next_process(table, 20));
+    TEST_ASSERT_EQUAL_PTR(ps[8], next_process(table, 25));
+    TEST_ASSERT_EQUAL_PTR(ps[2], next_process(table, 26));
+    TEST_ASSERT_EQUAL_PTR(ps[1], next_process(table, 40));
+    TEST_ASSERT_EQUAL_PTR(ps[0], next_process(table, 45));
+    free_process(ps[2]);
+    free_process(ps[8]);
+
+    // a batch right after the current REAL-TIME process preempts it.
+    Process next = create_process("/bin/next", REAL_TIME | SET_I(50) | SET_D(5));
+    TEST_ASSERT_TRUE(insertProcesses(table, &next, 1, status, policy(ps[0]), 50));
+    TEST_ASSERT_EQUAL_INT8(1, status[0]);
+
+    // table_show(table);
+    free_table(table);
+}
+
+void test_processes_are_found_by_pid(void){
+    ProcessTable table = create_table();
+    const int children = 5000;
+    Process* ps = malloc(children * sizeof(Process));
+    char buffer[MAX_PATH];
+    int i;
+
+    for (i = 0; i < children; i++){
+        sprintf(buffer, "child/%d", i);
+        ps[i] = create_process(buffer, ROUND_ROBIN);
+        set_pid(ps[i], 1000 + i);
+        TEST_ASSERT_FALSE(insertProcess(table, ps[i], 0, 0, 0));
+    }
+    TEST_ASSERT_NULL(find_pid(table, 0));
+    TEST_ASSERT_NULL(find_pid(table, 999));
+
+    // every other child is removed, which must not hide the others.
+    for (i = 0; i < children; i += 2)
+        TEST_ASSERT_TRUE(cancelProcess(table, get_handle(ps[i])));
+    for (i = 0; i < children; i++)
+        TEST_ASSERT_EQUAL_PTR(i % 2 ? ps[i] : NULL, find_pid(table, 1000 + i));
+
+    // a running child is still found, and its PID can change.
+    Process next = next_process(table, 0);
+    TEST_ASSERT_EQUAL_PTR(ps[1], next);
+    TEST_ASSERT_EQUAL_PTR(next, find_pid(table, 1001));
+    table_set_pid(table, next, 42);
+    TEST_ASSERT_NULL(find_pid(table, 1001));
+    TEST_ASSERT_EQUAL_PTR(next, find_pid(table, 42));
+    TEST_ASSERT_FALSE(insertProcess(table, next, ROUND_ROBIN, 0, 100));
+    TEST_ASSERT_EQUAL_PTR(next, find_pid(table, 42));
+
+    free(ps);
+    free_table(table);
+}
+
 void test_error_messages_fire(void){
     // for this test we need to create child
     // processes to die gruesome and horrible deaths
@@ -297,5 +758,15 @@ int main(void){
     RUN_TEST(test_set_and_get_quantum);
     RUN_TEST(test_set_and_get_ran);
     RUN_TEST(test_referential_process_resolves_correctly_and_runs_right_after);
+    RUN_TEST(test_fair_class_shares_time_by_weight);
+    RUN_TEST(test_fair_class_with_100k_processes);
+    RUN_TEST(test_classes_take_turns_and_give_slices);
+    RUN_TEST(test_slack_of_real_time_processes_is_reclaimed);
+    RUN_TEST(test_real_time_processes_are_placed_first_fit);
+    RUN_TEST(test_real_time_processes_wait_for_everything_they_make_reference_to);
+    RUN_TEST(test_jobs_are_removed_by_handle);
+    RUN_TEST(test_policies_are_changed_in_place);
+    RUN_TEST(test_processes_are_inserted_in_bulk);
+    RUN_TEST(test_processes_are_found_by_pid);
     return UNITY_END();
 }
\ No newline at end of file